@@ -17,6 +17,10 @@ public:
     virtual FString GetNotifyName_Implementation() const override;
     // End UAnimNotify interface
 
+    // Begin UObject interface
+    virtual void PostLoad() override;
+    // End UObject interface
+
     // If this sound should follow its owner
     UPROPERTY(EditAnywhere, Category = "FMOD Anim Notify")
     uint32 bFollow : 1;
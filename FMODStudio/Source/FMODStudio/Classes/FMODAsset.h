@@ -4,6 +4,7 @@
 
 #include "Misc/Guid.h"
 #include "CoreMinimal.h"
+#include "FMODStudioModule.h"
 #include "FMODAsset.generated.h"
 
 /**
@@ -24,6 +25,10 @@ class FMODSTUDIO_API UFMODAsset : public UObject
 
     FString FileName;
 
+    /** Studio handle looked up from AssetGuid for each system context, valid while the generation matches the module's */
+    mutable void *CachedHandles[EFMODSystemContext::Max];
+    mutable uint32 CachedHandleGenerations[EFMODSystemContext::Max];
+
     /** Force this to be an asset */
     virtual bool IsAsset() const override { return bShowAsAsset; }
 
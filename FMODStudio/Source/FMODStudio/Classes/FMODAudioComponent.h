@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Containers/Map.h"
+#include "Containers/CircularQueue.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Sound/SoundAttenuation.h"
 #include "AudioDevice.h"
@@ -50,6 +51,21 @@ struct FTimelineBeatProperties
     int32 TimeSignatureLower;
 };
 
+/** A marker or beat, passed from the FMOD thread to the game thread without locking or allocating */
+struct FTimelineCallbackProperties
+{
+    /** Longest marker name passed on, including the terminator.  Longer names are truncated. */
+    static const int32 MaxMarkerNameLength = 64;
+
+    /** False for a beat */
+    bool bIsMarker;
+
+    /** Copied in the callback, FMOD only guarantees the original for the duration of the callback */
+    ANSICHAR MarkerName[MaxMarkerNameLength];
+    int32 MarkerPosition;
+    FTimelineBeatProperties Beat;
+};
+
 USTRUCT(BlueprintType)
 struct FFMODAttenuationDetails
 {
@@ -93,10 +109,26 @@ struct FFMODOcclusionDetails
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FMOD|Occlusion", meta=(EditCondition = "bEnableOcclusion"))
     bool bUseComplexCollisionForOcclusion;
 
+    /** Number of rays cast towards the listener.  More rays give partial occlusion values between 0 and 1. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FMOD|Occlusion",
+        meta = (ClampMin = "1", ClampMax = "16", EditCondition = "bEnableOcclusion"))
+    int32 OcclusionRayCount;
+
+    /** Distance from the emitter that extra rays start from, spread around it facing the listener. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FMOD|Occlusion", meta = (ClampMin = "0.0", EditCondition = "bEnableOcclusion"))
+    float OcclusionRayRadius;
+
+    /** How strongly this emitter is favoured when occlusion traces are shared out between emitters. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FMOD|Occlusion", meta = (ClampMin = "0.0", EditCondition = "bEnableOcclusion"))
+    float OcclusionPriority;
+
     FFMODOcclusionDetails()
         : bEnableOcclusion(false)
         , OcclusionTraceChannel(ECC_Visibility)
         , bUseComplexCollisionForOcclusion(false)
+        , OcclusionRayCount(1)
+        , OcclusionRayRadius(50.0f)
+        , OcclusionPriority(1.0f)
     {}
 };
 
@@ -150,6 +182,11 @@ public:
     UPROPERTY(EditAnywhere, Category = FMODAudio)
     uint32 bEnableTimelineCallbacks : 1;
 
+    /** Release the event instance while out of range of every listener and restart it when back in range.
+     * Only applies to looping 3D events, and only when virtualization is enabled in the FMOD settings. */
+    UPROPERTY(EditAnywhere, Category = FMODAudio)
+    uint32 bAllowVirtualization : 1;
+
     /** Stored properties to apply next time we create an instance. */
     float StoredProperties[EFMODEventProperty::Count];
 
@@ -282,6 +319,21 @@ public:
     /** Cache default event parameter values. */
     void CacheDefaultParameterValues();
 
+    /** Send the current transform to the event instance straight away. */
+    void Update3DAttributes();
+
+    /** Send already converted 3D attributes to the event instance and update anything that depends on position. */
+    void Apply3DAttributes(const FMOD_3D_ATTRIBUTES &Attributes);
+
+    /** Return the 3D maximum distance in effect for the event, in FMOD units. */
+    float GetVirtualizationDistance() const;
+
+    /** Release the event instance while staying active, remembering where the timeline was. */
+    void Virtualize();
+
+    /** Restart a virtual component close to where its timeline would have reached. */
+    void Devirtualize();
+
 public:
     /** Internal play function which can play events in the editor. */
     void PlayInternal(EFMODSystemContext::Type Context);
@@ -355,15 +407,37 @@ private:
     float AmbientLPF;
     float LastVolume;
     float LastLPF;
-    bool wasOccluded;
+    float OcclusionTarget;
+    float OcclusionCurrent;
     FMOD_STUDIO_PARAMETER_ID OcclusionID;
     FMOD_STUDIO_PARAMETER_ID AmbientVolumeID;
     FMOD_STUDIO_PARAMETER_ID AmbientLPFID;
 
     // Tempo and marker callbacks.
     FCriticalSection CallbackLock;
-    TArray<FTimelineMarkerProperties> CallbackMarkerQueue;
-    TArray<FTimelineBeatProperties> CallbackBeatQueue;
+    TUniquePtr<TCircularQueue<FTimelineCallbackProperties>> TimelineCallbackQueue;
+    FThreadSafeCounter DroppedTimelineCallbacks;
+
+    // Metadata for the event description being played, shared between components.
+    TSharedPtr<const struct FFMODEventDescriptionInfo, ESPMode::ThreadSafe> EventInfo;
+
+    // Batched 3D attribute submission.
+    friend class FFMODEmitterManager;
+    FTransform LastSubmittedTransform;
+    bool bTransformDirty;
+
+    // Occlusion traces and smoothing.
+    friend class FFMODOcclusionManager;
+
+    // Virtualization of inaudible components.
+    friend class FFMODSignificanceManager;
+    bool bVirtual;
+    int32 VirtualTimelinePosition;
+    float VirtualStartTime;
+    float EventMaximumDistance;
+
+    // Play was called before the runtime system finished initializing.
+    bool bPlayQueued;
 
     // Direct assignment of programmer sound from other C++ code.
     FMOD::Sound *ProgrammerSound;
@@ -53,6 +53,7 @@ class FMODSTUDIO_API UFMODBlueprintStatics : public UBlueprintFunctionLibrary
     static FFMODEventInstance PlayEvent2D(UObject *WorldContextObject, UFMODEvent *Event, bool bAutoPlay);
 
     /** Plays an event at the given location. This returns an FMOD Event Instance.  The sound does not travel with any actor.
+	 * Auto played events that have pooling enabled return an invalid instance, since the pool reuses it once it stops.
 	 * @param Event - event to play
 	 * @param Location - World position to play event at
 	 * @param bAutoPlay - Start the event automatically.
@@ -121,6 +122,22 @@ class FMODSTUDIO_API UFMODBlueprintStatics : public UBlueprintFunctionLibrary
     UFUNCTION(BlueprintCallable, Category = "Audio|FMOD", meta = (UnsafeDuringActorConstruction = "true"))
     static void UnloadBankSampleData(class UFMODBank *Bank);
 
+    /** Add a reference to a bank, loading it if this is the first.  Every call must be paired with Release Bank.
+	 * Sample data that is no longer referenced is kept within the sample data budget set in the FMOD settings.
+	 * @param Bank - bank to acquire
+	 * @param bSampleData - also reference the bank's sample data, loading it if needed
+	 * @return true if the bank is loaded or loading
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD", meta = (UnsafeDuringActorConstruction = "true"))
+    static bool AcquireBank(class UFMODBank *Bank, bool bSampleData);
+
+    /** Drop a reference added by Acquire Bank.  The bank is unloaded once nothing references it or its sample data.
+	 * @param Bank - bank to release
+	 * @param bSampleData - must match the value passed to Acquire Bank
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD", meta = (UnsafeDuringActorConstruction = "true"))
+    static void ReleaseBank(class UFMODBank *Bank, bool bSampleData);
+
     /** Load event sample data.  This can be done ahead of time to avoid loading stalls.
 	 * @param Event - event to load sample data from.
 	 */
@@ -135,6 +152,26 @@ class FMODSTUDIO_API UFMODBlueprintStatics : public UBlueprintFunctionLibrary
         meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", UnsafeDuringActorConstruction = "true"))
     static void UnloadEventSampleData(UObject *WorldContextObject, UFMODEvent *Event);
 
+    /** Enable instance pooling for an event, so that fire and forget playback reuses stopped instances.
+	 * @param Event - event to pool instances of.
+	 * @param PrewarmSize - number of instances to create up front.
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD", meta = (UnsafeDuringActorConstruction = "true"))
+    static void EnableEventPooling(UFMODEvent *Event, int32 PrewarmSize);
+
+    /** Disable instance pooling for an event and release its idle instances.
+	 * @param Event - event to stop pooling instances of.
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD", meta = (UnsafeDuringActorConstruction = "true"))
+    static void DisableEventPooling(UFMODEvent *Event);
+
+    /** Start loading programmer sounds in the background so they are ready when their instruments are triggered.
+	 * Prefetched sounds are kept within the programmer sound cache budget set in the FMOD settings.
+	 * @param SoundNames - file paths or audio table keys, as used for programmer sound names.
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD", meta = (UnsafeDuringActorConstruction = "true"))
+    static void PrefetchProgrammerSounds(const TArray<FString> &SoundNames);
+
     /** Return a list of all event instances that are playing for this event.
 		Be careful using this function because it is possible to find and alter any playing sound, even ones owned by other audio components.
 	 * @param Event - event to find instances from.
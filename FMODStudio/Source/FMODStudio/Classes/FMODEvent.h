@@ -15,6 +15,14 @@ class FMODSTUDIO_API UFMODEvent : public UFMODAsset
 {
     GENERATED_UCLASS_BODY()
 
+    /** Reuse stopped instances of this event for fire and forget playback.  Set from the Pooled Events setting or EnableEventPooling. */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = Pooling)
+    bool bPoolInstances;
+
+    /** Number of instances created up front when pooling is enabled */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = Pooling)
+    int32 PoolPrewarmSize;
+
     /** Get tags to show in content view */
     virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag> &OutTags) const override;
 
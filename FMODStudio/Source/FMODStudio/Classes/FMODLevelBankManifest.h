@@ -0,0 +1,25 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "Engine/AssetUserData.h"
+#include "UObject/SoftObjectPath.h"
+#include "FMODLevelBankManifest.generated.h"
+
+/**
+ * FMOD banks and events used by a level, recorded when the level is saved or cooked.
+ * Attached to the level so the banks and event sample data can be loaded as it streams in.
+ */
+UCLASS()
+class FMODSTUDIO_API UFMODLevelBankManifest : public UAssetUserData
+{
+    GENERATED_UCLASS_BODY()
+
+    /** Banks containing the events below */
+    UPROPERTY(VisibleAnywhere, Category = FMOD)
+    TArray<FSoftObjectPath> Banks;
+
+    /** Events referenced by components, ambient sounds, anim notifies and sequences in the level */
+    UPROPERTY(VisibleAnywhere, Category = FMOD)
+    TArray<FSoftObjectPath> Events;
+};
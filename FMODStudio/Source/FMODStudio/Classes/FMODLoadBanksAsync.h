@@ -0,0 +1,54 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "FMODLoadBanksAsync.generated.h"
+
+class UFMODBank;
+class FFMODBankLoadRequest;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFMODLoadBanksProgress, float, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnFMODLoadBanksFinished);
+
+/**
+ * Latent Blueprint node that loads banks without blocking the game thread.
+ */
+UCLASS()
+class FMODSTUDIO_API UFMODLoadBanksAsync : public UBlueprintAsyncActionBase
+{
+    GENERATED_UCLASS_BODY()
+
+    /** Called whenever more of the banks have finished loading, with progress from 0 to 1 */
+    UPROPERTY(BlueprintAssignable)
+    FOnFMODLoadBanksProgress OnProgress;
+
+    /** Called once every bank has loaded */
+    UPROPERTY(BlueprintAssignable)
+    FOnFMODLoadBanksFinished Completed;
+
+    /** Called once every bank has finished loading, if any of them failed */
+    UPROPERTY(BlueprintAssignable)
+    FOnFMODLoadBanksFinished Failed;
+
+    /** Loads banks in the background, optionally followed by their sample data.
+	 * @param Banks - banks to load
+	 * @param bLoadSampleData - also load the sample data of each bank before completing
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD", meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"))
+    static UFMODLoadBanksAsync *LoadBanksAsync(UObject *WorldContextObject, const TArray<UFMODBank *> &Banks, bool bLoadSampleData);
+
+    // UBlueprintAsyncActionBase interface
+    virtual void Activate() override;
+
+private:
+    void HandleProgress(float Progress);
+    void HandleCompleted(bool bSucceeded);
+
+    UPROPERTY()
+    TArray<UFMODBank *> Banks;
+
+    bool bLoadSampleData;
+
+    TSharedPtr<FFMODBankLoadRequest> Request;
+};
@@ -4,6 +4,7 @@
 
 #include "UObject/Class.h"
 #include "Engine/EngineTypes.h"
+#include "UObject/SoftObjectPath.h"
 #include "GenericPlatform/GenericPlatform.h"
 #include "FMODSettings.generated.h"
 
@@ -70,6 +71,37 @@ struct FCustomPoolSizes
     }
 };
 
+USTRUCT()
+struct FFMODSampleDataBudget
+{
+    GENERATED_USTRUCT_BODY()
+
+    /** Default = 0 (Unload as soon as released) units in megabytes*/
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 Desktop;
+    /** Default = 0 (Unload as soon as released) units in megabytes*/
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 Mobile;
+    /** Default = 0 (Unload as soon as released) units in megabytes*/
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 PS4;
+    /** Default = 0 (Unload as soon as released) units in megabytes*/
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 Switch;
+    /** Default = 0 (Unload as soon as released) units in megabytes*/
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 XboxOne;
+
+    FFMODSampleDataBudget()
+        : Desktop(0)
+        , Mobile(0)
+        , PS4(0)
+        , Switch(0)
+        , XboxOne(0)
+    {
+    }
+};
+
 USTRUCT()
 struct FFMODProjectLocale
 {
@@ -94,6 +126,29 @@ struct FFMODProjectLocale
     bool bDefault;
 };
 
+USTRUCT()
+struct FFMODPooledEvent
+{
+    GENERATED_USTRUCT_BODY()
+
+    /**
+    * Event whose fire and forget instances are pooled.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (AllowedClasses = "FMODEvent"))
+    FSoftObjectPath Event;
+
+    /**
+    * Number of instances created when the banks are loaded.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 PrewarmSize;
+
+    FFMODPooledEvent()
+        : PrewarmSize(0)
+    {
+    }
+};
+
 UCLASS(config = Engine, defaultconfig)
 class FMODSTUDIO_API UFMODSettings : public UObject
 {
@@ -196,12 +251,62 @@ public:
     UPROPERTY(config, EditAnywhere, Category = InitSettings)
     int32 FileBufferSize;
 
+    /**
+	 * Service FMOD file reads asynchronously on a pool of worker threads, ordered by FMOD's read priority.
+	 * Allows stream and bank reads on different files to be in flight at the same time.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings)
+    bool bAsyncFileReads;
+
+    /**
+	 * Number of worker threads servicing asynchronous file reads (2 by default).
+	 */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings, meta = (ClampMin = "1", EditCondition = "bAsyncFileReads"))
+    int32 AsyncFileReadThreads;
+
     /**
 	 * Studio update period in milliseconds, or 0 for default (which means 20ms).
 	 */
     UPROPERTY(config, EditAnywhere, Category = InitSettings)
     int32 StudioUpdatePeriod;
 
+    /**
+	 * Update the runtime Studio system from its own thread at a fixed rate instead of from the game's render tick.
+	 * Keeps audio responsive when the frame rate drops and takes the update cost off the game frame.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings)
+    bool bUseDedicatedUpdateThread;
+
+    /**
+	 * Number of times per second the dedicated update thread updates the Studio system (60 by default).
+	 */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings, meta = (ClampMin = "10", ClampMax = "500", EditCondition = "bUseDedicatedUpdateThread"))
+    float UpdateThreadRate;
+
+    /**
+	 * Initialize the runtime system with FMOD_STUDIO_INIT_SYNCHRONOUS_UPDATE so FMOD doesn't create its own Studio thread, and
+	 * run each update as a task graph task once the game thread has submitted the frame's audio, overlapping with rendering.
+	 * Ignored when the dedicated update thread is used.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings)
+    bool bUpdateFromTaskGraph;
+
+    /**
+	 * Record volume, pitch, pause, parameter, 3D attribute, start, stop and release calls on event instances during the frame
+	 * and make them in one burst just before the Studio update, keeping only the last value written to each parameter.
+	 * Values read back from an instance don't reflect calls made earlier in the same frame.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings)
+    bool bUseCommandBuffer;
+
+    /**
+	 * Initialize the runtime system with FMOD_STUDIO_INIT_SYNCHRONOUS_UPDATE and FMOD_INIT_THREAD_UNSAFE, removing FMOD's API locks.
+	 * Studio processing then happens on the game thread during the update.  Ignored with the dedicated update thread or
+	 * asynchronous initialization or updating from the task graph, which call FMOD from other threads.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings, meta = (EditCondition = "bUseCommandBuffer"))
+    bool bThreadUnsafeRuntimeSystem;
+
     /**
 	 * Output device to choose at system start up, or empty for default.
 	 */
@@ -214,6 +319,28 @@ public:
     UPROPERTY(config, EditAnywhere, Category = InitSettings)
     bool bLockAllBuses;
 
+    /**
+	 * Memory map bank files and point FMOD at the mapping instead of copying the banks into FMOD's heap.
+	 * Processes loading the same banks can then share their pages.  Falls back to regular loading where mapping is unsupported.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings)
+    bool bMemoryMapBanks;
+
+    /**
+	 * In packaged games, create the runtime system and load banks on a background thread while the engine keeps starting up.
+	 * Events played before it is ready are started once it is.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings)
+    bool bInitializeAsynchronously;
+
+    /**
+	 * In the editor, keep the runtime system and its banks loaded when PIE ends so the next session can start straight away.
+	 * Playing instances, global parameters, listeners and banks loaded during the session are reset instead.
+	 * The system is recreated if settings change or master banks are rebuilt.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings)
+    bool bKeepRuntimeSystemBetweenPIESessions;
+
     /** 
      * Use specified memory pool size for platform, units in bytes. Disabled by default.
      * FMOD may become unstable if the limit is exceeded!
@@ -221,6 +348,13 @@ public:
     UPROPERTY(config, EditAnywhere, Category = InitSettings)
     FCustomPoolSizes MemoryPoolSizes;
 
+    /**
+	 * When no memory pool size is set, serve FMOD's small allocations from size class pools instead of the engine allocator.
+	 * Sample data and stream buffers still use the engine allocator.  Takes effect on the next restart.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings)
+    bool bUsePooledAllocator;
+
     /**
 	 * Live update port to use, or 0 for default.
 	 */
@@ -246,6 +380,99 @@ public:
     UPROPERTY(config, EditAnywhere, Category = Advanced)
     FString ContentBrowserPrefix;
 
+    /**
+	 * Outside the editor, only construct FMOD asset objects the first time they are looked up by name or referenced
+	 * from a loaded FMOD audio component or anim notify.  Reduces startup time and memory for large projects.
+	 * Other content holding direct references to FMOD assets should look them up through FindAssetByPath.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced)
+    bool bLazyAssetCreation;
+
+    /**
+	 * Queue moved FMOD audio components and send all their 3D attributes together just before each Studio update,
+	 * rather than calling into FMOD every time a component's transform changes.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced)
+    bool bBatch3DAttributes;
+
+    /**
+	 * When batching 3D attributes, ignore emitter moves shorter than this distance in centimetres.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0.0", EditCondition = "bBatch3DAttributes"))
+    float EmitterMoveThreshold;
+
+    /**
+	 * When batching 3D attributes, ignore emitter rotations smaller than this angle in degrees.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0.0", EditCondition = "bBatch3DAttributes"))
+    float EmitterRotationThreshold;
+
+    /**
+	 * Events that reuse stopped instances for fire and forget playback, such as footsteps and gunshots.
+	 * Pooling can also be turned on at runtime with Enable Event Pooling.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced)
+    TArray<FFMODPooledEvent> PooledEvents;
+
+    /**
+	 * Release the event instances of looping 3D audio components that are beyond their maximum distance from every listener,
+	 * and restart them from an estimated timeline position when they come back into range.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced)
+    bool bVirtualizeInaudibleComponents;
+
+    /**
+	 * How often in seconds audio components are re-ranked for virtualization.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0.0", EditCondition = "bVirtualizeInaudibleComponents"))
+    float VirtualizationInterval;
+
+    /**
+	 * Fraction of the maximum distance a playing component may move beyond it before being virtualized, to avoid restarting
+	 * components that sit on the boundary.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0.0", EditCondition = "bVirtualizeInaudibleComponents"))
+    float VirtualizationMargin;
+
+    /**
+	 * Maximum number of virtualizable audio components holding an event instance at once, keeping the closest ones.  0 means no limit.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0", EditCondition = "bVirtualizeInaudibleComponents"))
+    int32 MaxRealComponents;
+
+    /**
+	 * Maximum number of occlusion rays traced per world each frame.  Emitters that don't fit wait for a later frame.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "1"))
+    int32 OcclusionTraceBudget;
+
+    /**
+	 * Time in seconds for the occlusion parameter to move from fully clear to fully occluded.  0 applies trace results immediately.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0.0"))
+    float OcclusionSmoothingTime;
+
+    /**
+	 * Memory in megabytes kept for programmer sounds that are no longer playing, so that repeated lines don't have to be reloaded.
+	 * 0 releases programmer sounds as soon as they finish.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 ProgrammerSoundCacheSize;
+
+    /**
+	 * Sample data in megabytes that banks acquired with Acquire Bank may keep loaded after nothing references it, per platform.
+	 * Least recently used sample data is unloaded first once the budget is exceeded.  0 unloads it as soon as it is released.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced)
+    FFMODSampleDataBudget SampleDataBudget;
+
+    /**
+	 * Load the banks and event sample data a level uses when it is added to the world, and release them when it is removed.
+	 * Each level's list is recorded in the editor whenever the level is saved or cooked while this is enabled.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Advanced)
+    bool bPreloadLevelBanks;
+
     /**
 	 * Force platform directory name, or leave empty for automatic (Desktop/Mobile/PS4/XBoxOne)
 	 */
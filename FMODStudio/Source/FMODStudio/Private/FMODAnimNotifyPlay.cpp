@@ -1,6 +1,7 @@
 
 #include "FMODAnimNotifyPlay.h"
 #include "FMODBlueprintStatics.h"
+#include "FMODStudioModule.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Kismet/KismetSystemLibrary.h"
 
@@ -13,6 +14,17 @@ UFMODAnimNotifyPlay::UFMODAnimNotifyPlay()
 #endif // WITH_EDITORONLY_DATA
 }
 
+void UFMODAnimNotifyPlay::PostLoad()
+{
+    Super::PostLoad();
+
+    // Make sure the event asset exists when assets are created on demand
+    if (!Event.IsNull() && !Event.IsValid())
+    {
+        IFMODStudioModule::Get().FindAssetByPath(Event.ToSoftObjectPath());
+    }
+}
+
 void UFMODAnimNotifyPlay::Notify(USkeletalMeshComponent *MeshComp, UAnimSequenceBase *AnimSeq)
 {
     if (Event.IsValid())
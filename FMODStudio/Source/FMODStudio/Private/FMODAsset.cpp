@@ -8,6 +8,8 @@ static const TCHAR *FMODAssetTypeStrings[] = { TEXT("Bank"), TEXT("Event"), TEXT
 UFMODAsset::UFMODAsset(const FObjectInitializer &ObjectInitializer)
     : Super(ObjectInitializer)
 {
+    FMemory::Memzero(CachedHandles);
+    FMemory::Memzero(CachedHandleGenerations);
 }
 
 /** Get tags to show in content view */
@@ -12,16 +12,159 @@
 #include "FMODFileCallbacks.h"
 #include "FMODStudioPrivatePCH.h"
 #include "fmod_studio.hpp"
+#include "Async/ParallelFor.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/Archive.h"
+#include "Serialization/BufferReader.h"
+#include "Templates/UniquePtr.h"
 #include "UObject/Package.h"
 
 #if WITH_EDITOR
 #include "AssetRegistryModule.h"
 #endif
 
+namespace
+{
+// Bank files are RIFF containers of form type 'FEV '.  The bank GUID lives in the bank info chunk,
+// nested in the project list, directly after the chunk's format version.
+constexpr uint32 MakeChunkId(const char (&Id)[5])
+{
+    return (uint32)Id[0] | ((uint32)Id[1] << 8) | ((uint32)Id[2] << 16) | ((uint32)Id[3] << 24);
+}
+
+const uint32 RiffChunkId = MakeChunkId("RIFF");
+const uint32 ListChunkId = MakeChunkId("LIST");
+const uint32 BankFormType = MakeChunkId("FEV ");
+const uint32 BankInfoChunkId = MakeChunkId("BNKI");
+
+bool FindBankInfoChunk(FArchive &Archive, int64 Start, int64 End, int32 Depth)
+{
+    int64 Position = Start;
+
+    while (Position + 8 <= End)
+    {
+        uint32 ChunkId = 0;
+        uint32 ChunkSize = 0;
+        Archive.Seek(Position);
+        Archive << ChunkId << ChunkSize;
+
+        if (Archive.IsError())
+        {
+            return false;
+        }
+
+        int64 DataStart = Position + 8;
+        int64 DataEnd = FMath::Min(DataStart + (int64)ChunkSize, End);
+
+        if (ChunkId == BankInfoChunkId)
+        {
+            return true;
+        }
+        else if (ChunkId == ListChunkId && Depth < 4)
+        {
+            // Skip the list type
+            if (FindBankInfoChunk(Archive, DataStart + 4, DataEnd, Depth + 1))
+            {
+                return true;
+            }
+        }
+
+        // Chunks are padded to an even size
+        Position = DataStart + Align((int64)ChunkSize, 2);
+    }
+
+    return false;
+}
+
+bool ReadBankGuidFromHeader(const FString &BankPath, FGuid &OutGuid)
+{
+    TUniquePtr<FArchive> Archive(IFileManager::Get().CreateFileReader(*BankPath, FILEREAD_Silent));
+    if (!Archive)
+    {
+        return false;
+    }
+
+    uint32 ChunkId = 0;
+    uint32 ChunkSize = 0;
+    uint32 FormType = 0;
+    *Archive << ChunkId << ChunkSize << FormType;
+
+    if (Archive->IsError() || ChunkId != RiffChunkId || FormType != BankFormType)
+    {
+        return false;
+    }
+
+    int64 End = FMath::Min((int64)ChunkSize + 8, Archive->TotalSize());
+    if (!FindBankInfoChunk(*Archive, 12, End, 0))
+    {
+        return false;
+    }
+
+    uint32 Version = 0;
+    FMOD_GUID Guid;
+    *Archive << Version;
+    Archive->Serialize(&Guid, sizeof(Guid));
+
+    if (Archive->IsError())
+    {
+        return false;
+    }
+
+    OutGuid = FMODUtils::ConvertGuid(Guid);
+    return OutGuid.IsValid();
+}
+
+const uint32 ManifestMagic = MakeChunkId("FMAT");
+const int32 ManifestVersion = 1;
+
+FString GetManifestPath()
+{
+#if WITH_EDITOR
+    return FPaths::ProjectIntermediateDir() / TEXT("FMOD") / TEXT("AssetTable.manifest");
+#else
+    return FPaths::ProjectSavedDir() / TEXT("FMOD") / TEXT("AssetTable.manifest");
+#endif
+}
+
+// Anything in the settings which changes how bank files map onto the table invalidates the manifest
+FString GetManifestSettingsKey(const UFMODSettings &Settings)
+{
+    FString Key = Settings.GetFullBankPath() + TEXT("|") + Settings.MasterBankName;
+    for (const FFMODProjectLocale &Locale : Settings.Locales)
+    {
+        Key += TEXT("|") + Locale.LocaleCode;
+    }
+    return Key;
+}
+}
+
+FArchive &operator<<(FArchive &Ar, FFMODAssetTable::FBankFile &BankFile)
+{
+    Ar << BankFile.Path;
+    Ar << BankFile.Size;
+    Ar << BankFile.Timestamp;
+    Ar << BankFile.Hash;
+    Ar << BankFile.Guid;
+    return Ar;
+}
+
+FArchive &operator<<(FArchive &Ar, FFMODAssetTable::FAssetEntry &Entry)
+{
+    Ar << Entry.Guid;
+    Ar << Entry.FullName;
+    return Ar;
+}
+
 FFMODAssetTable::FFMODAssetTable()
     : StudioSystem(nullptr)
+    , bActive(false)
+    , bLazyAssetCreation(false)
+    , bEventBankLookupValid(false)
 {
 }
 
@@ -34,6 +177,18 @@ void FFMODAssetTable::Create()
 {
     Destroy();
 
+    // The sandbox system is only created once a refresh actually needs to look inside the banks
+    bActive = true;
+    bLazyAssetCreation = !GIsEditor && GetDefault<UFMODSettings>()->bLazyAssetCreation;
+}
+
+FMOD::Studio::System *FFMODAssetTable::GetStudioSystem()
+{
+    if (StudioSystem != nullptr)
+    {
+        return StudioSystem;
+    }
+
     // Create a sandbox system purely for loading and considering banks
     verifyfmod(FMOD::Studio::System::create(&StudioSystem));
     FMOD::System *lowLevelSystem = nullptr;
@@ -42,6 +197,8 @@ void FFMODAssetTable::Create()
     AttachFMODFileSystem(lowLevelSystem, 2048);
     verifyfmod(
         StudioSystem->initialize(1, FMOD_STUDIO_INIT_ALLOW_MISSING_PLUGINS | FMOD_STUDIO_INIT_SYNCHRONOUS_UPDATE, FMOD_INIT_MIX_FROM_UPDATE, 0));
+
+    return StudioSystem;
 }
 
 void FFMODAssetTable::Destroy()
@@ -51,26 +208,55 @@ void FFMODAssetTable::Destroy()
         verifyfmod(StudioSystem->release());
     }
     StudioSystem = nullptr;
+    bActive = false;
+    EventBankLookup.Reset();
+    bEventBankLookupValid = false;
 }
 
-UFMODAsset *FFMODAssetTable::FindByName(const FString &Name) const
+UFMODAsset *FFMODAssetTable::FindByName(const FString &Name)
 {
     const TWeakObjectPtr<UFMODAsset> *FoundAsset = FullNameLookup.Find(Name);
-    if (FoundAsset)
+    if (FoundAsset && FoundAsset->IsValid())
     {
         return FoundAsset->Get();
     }
+
+    // Assets are only constructed on first use when creation is lazy
+    const FAssetIndexEntry *Entry = AssetIndex.Find(Name);
+    if (Entry)
+    {
+        return MaterializeAsset(Name, *Entry);
+    }
     return nullptr;
 }
 
 void FFMODAssetTable::Refresh()
 {
-    if (StudioSystem == nullptr)
+    if (!bActive)
+    {
+        return;
+    }
+
+    // Keep what we knew about the banks so callers can work out which ones changed
+    LastBankFiles = BankFiles;
+    bEventBankLookupValid = false;
+    AddedAssets.Reset();
+    RemovedAssets.Reset();
+
+    TArray<FBankFile> PreviousBankFiles;
+    GetBankFilesFromDisk(BankFiles);
+
+    // The manifest only exists to skip parsing unchanged banks and to detect changes while editing.  Cooked builds destroy
+    // the table straight after startup, so hashing every bank to write one would only slow down the first launch.
+    if (GIsEditor && LoadManifest(PreviousBankFiles))
     {
         return;
     }
 
+    UE_LOG(LogFMOD, Log, TEXT("Asset table manifest out of date, rebuilding from banks"));
+
     BuildBankPathLookup();
+    TArray<FAssetEntry> Assets;
 
     if (!MasterStringsBankPath.IsEmpty())
     {
@@ -80,9 +266,11 @@ void FFMODAssetTable::Refresh()
         UE_LOG(LogFMOD, Log, TEXT("Loading strings bank: %s"), *StringPath);
 
         FMOD::Studio::Bank *StudioStringBank;
-        FMOD_RESULT StringResult = StudioSystem->loadBankFile(TCHAR_TO_UTF8(*StringPath), FMOD_STUDIO_LOAD_BANK_NORMAL, &StudioStringBank);
+        FMOD_RESULT StringResult = GetStudioSystem()->loadBankFile(TCHAR_TO_UTF8(*StringPath), FMOD_STUDIO_LOAD_BANK_NORMAL, &StudioStringBank);
         if (StringResult == FMOD_OK)
         {
+            TSet<FGuid> KnownBankGuids;
+            TSet<FString> KnownAssetNames;
             TArray<char> RawBuffer;
             RawBuffer.SetNum(256); // Initial capacity
 
@@ -110,11 +298,37 @@ void FFMODAssetTable::Refresh()
                 FGuid AssetGuid = FMODUtils::ConvertGuid(Guid);
                 if (!AssetName.IsEmpty())
                 {
+                    if (AssetName.StartsWith(TEXT("bank:")))
+                    {
+                        KnownBankGuids.Add(AssetGuid);
+                    }
                     AddAsset(AssetGuid, AssetName);
+                    Assets.Add(FAssetEntry{ AssetGuid, AssetName });
+                    KnownAssetNames.Add(AssetName);
                 }
             }
             verifyfmod(StudioStringBank->unload());
             verifyfmod(StudioSystem->update());
+
+            // Anything the strings bank no longer lists has been removed from the project
+            TArray<FString> StaleAssetNames;
+            for (const TMap<FString, FAssetIndexEntry>::ElementType &Entry : AssetIndex)
+            {
+                if (!KnownAssetNames.Contains(Entry.Key))
+                {
+                    StaleAssetNames.Add(Entry.Key);
+                }
+            }
+            for (const FString &StaleAssetName : StaleAssetNames)
+            {
+                RemoveAsset(StaleAssetName);
+            }
+
+            ValidateBankPathLookup(KnownBankGuids);
+            if (GIsEditor)
+            {
+                SaveManifest(PreviousBankFiles, Assets);
+            }
         }
         else
         {
@@ -123,8 +337,283 @@ void FFMODAssetTable::Refresh()
     }
 }
 
+bool FFMODAssetTable::GetChangedBankFiles(TArray<FString> &OutChangedBankFiles) const
+{
+    OutChangedBankFiles.Reset();
+
+    // Without hashes for both the old and new bank files there is nothing to compare
+    if (LastBankFiles.Num() == 0)
+    {
+        return false;
+    }
+
+    TMap<FString, const FBankFile *> LastLookup;
+    for (const FBankFile &LastFile : LastBankFiles)
+    {
+        if (!LastFile.Hash.IsValid())
+        {
+            return false;
+        }
+        LastLookup.Add(LastFile.Path, &LastFile);
+    }
+
+    for (const FBankFile &BankFile : BankFiles)
+    {
+        if (!BankFile.Hash.IsValid())
+        {
+            return false;
+        }
+
+        const FBankFile *LastFile = nullptr;
+        if (LastLookup.RemoveAndCopyValue(BankFile.Path, LastFile) && LastFile->Hash == BankFile.Hash)
+        {
+            continue;
+        }
+        OutChangedBankFiles.Add(BankFile.Path);
+    }
+
+    // Whatever is left over has been deleted
+    for (const TMap<FString, const FBankFile *>::ElementType &LastFile : LastLookup)
+    {
+        OutChangedBankFiles.Add(LastFile.Key);
+    }
+
+    return true;
+}
+
+void FFMODAssetTable::GetAssetChanges(TArray<FGuid> &OutAddedAssets, TArray<FGuid> &OutRemovedAssets) const
+{
+    OutAddedAssets = AddedAssets;
+    OutRemovedAssets = RemovedAssets;
+}
+
+bool FFMODAssetTable::LoadManifest(TArray<FBankFile> &OutManifestBankFiles)
+{
+    FString ManifestPath = GetManifestPath();
+
+    // Map the manifest rather than reading it when the platform allows
+    TUniquePtr<IMappedFileHandle> MappedHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*ManifestPath));
+    TUniquePtr<IMappedFileRegion> MappedRegion(MappedHandle ? MappedHandle->MapRegion() : nullptr);
+    TArray<uint8> ManifestData;
+    TUniquePtr<FArchive> Reader;
+
+    if (MappedRegion)
+    {
+        Reader = MakeUnique<FBufferReader>((void *)MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize(), false);
+    }
+    else if (FFileHelper::LoadFileToArray(ManifestData, *ManifestPath, FILEREAD_Silent))
+    {
+        Reader = MakeUnique<FBufferReader>(ManifestData.GetData(), ManifestData.Num(), false);
+    }
+    else
+    {
+        return false;
+    }
+
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+
+    uint32 Magic = 0;
+    int32 Version = 0;
+    FString SettingsKey;
+    TArray<FAssetEntry> Assets;
+
+    *Reader << Magic << Version;
+    if (Reader->IsError() || Magic != ManifestMagic || Version != ManifestVersion)
+    {
+        return false;
+    }
+
+    *Reader << SettingsKey << OutManifestBankFiles << Assets;
+    if (Reader->IsError() || SettingsKey != GetManifestSettingsKey(Settings))
+    {
+        OutManifestBankFiles.Reset();
+        return false;
+    }
+
+    if (!ResolveBankFiles(OutManifestBankFiles, true))
+    {
+        return false;
+    }
+
+    UE_LOG(LogFMOD, Log, TEXT("Using asset table manifest: %s"), *ManifestPath);
+
+    BankPathLookup.Empty(BankFiles.Num());
+    MasterBankPath.Empty();
+    MasterStringsBankPath.Empty();
+    MasterAssetsBankPath.Empty();
+
+    for (const FBankFile &BankFile : BankFiles)
+    {
+        AddBankPath(BankFile.Guid, Settings.GetFullBankPath() / BankFile.Path);
+    }
+
+    for (const FAssetEntry &Asset : Assets)
+    {
+        AddAsset(Asset.Guid, Asset.FullName);
+    }
+
+    // Banks may have been touched without changing, keep the stored timestamps current
+    bool bTimestampsChanged = false;
+    for (int32 Index = 0; Index < BankFiles.Num(); ++Index)
+    {
+        bTimestampsChanged |= (BankFiles[Index].Timestamp != OutManifestBankFiles[Index].Timestamp);
+    }
+
+    if (bTimestampsChanged)
+    {
+        Reader.Reset();
+        MappedRegion.Reset();
+        MappedHandle.Reset();
+        WriteManifest(Assets);
+    }
+
+    return true;
+}
+
+bool FFMODAssetTable::ResolveBankFiles(const TArray<FBankFile> &ManifestBankFiles, bool bRequireMatch)
+{
+    TMap<FString, const FBankFile *> ManifestLookup;
+    for (const FBankFile &ManifestFile : ManifestBankFiles)
+    {
+        ManifestLookup.Add(ManifestFile.Path, &ManifestFile);
+    }
+
+    // Reuse hashes for files whose size and timestamp are unchanged, and hash the rest
+    TArray<int32> FilesToHash;
+    for (int32 Index = 0; Index < BankFiles.Num(); ++Index)
+    {
+        FBankFile &BankFile = BankFiles[Index];
+        const FBankFile *const *ManifestFile = ManifestLookup.Find(BankFile.Path);
+
+        if (ManifestFile && (*ManifestFile)->Size == BankFile.Size)
+        {
+            BankFile.Guid = (*ManifestFile)->Guid;
+            if ((*ManifestFile)->Timestamp == BankFile.Timestamp)
+            {
+                BankFile.Hash = (*ManifestFile)->Hash;
+                continue;
+            }
+        }
+        else if (bRequireMatch)
+        {
+            return false;
+        }
+
+        FilesToHash.Add(Index);
+    }
+
+    if (bRequireMatch && ManifestBankFiles.Num() != BankFiles.Num())
+    {
+        return false;
+    }
+
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    FString BankDir = Settings.GetFullBankPath();
+
+    ParallelFor(FilesToHash.Num(), [this, &FilesToHash, &BankDir](int32 Index) {
+        FBankFile &BankFile = BankFiles[FilesToHash[Index]];
+        BankFile.Hash = FMD5Hash::HashFile(*(BankDir / BankFile.Path));
+    });
+
+    if (bRequireMatch)
+    {
+        for (int32 Index : FilesToHash)
+        {
+            if (BankFiles[Index].Hash != (*ManifestLookup.FindChecked(BankFiles[Index].Path))->Hash)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void FFMODAssetTable::SaveManifest(const TArray<FBankFile> &PreviousBankFiles, TArray<FAssetEntry> &Assets)
+{
+    ResolveBankFiles(PreviousBankFiles, false);
+
+    // The lookup holds the final GUID for every path, including any corrected by validation
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    TMap<FString, FGuid> PathToGuid;
+    for (const TMap<FGuid, BankLocalizations>::ElementType &Localizations : BankPathLookup)
+    {
+        for (const BankLocalization &Localization : Localizations.Value)
+        {
+            PathToGuid.Add(Localization.Path, Localizations.Key);
+        }
+    }
+
+    for (FBankFile &BankFile : BankFiles)
+    {
+        const FGuid *Guid = PathToGuid.Find(BankFile.Path);
+        if (!Guid)
+        {
+            // Unregistered banks would be lost when loading the manifest
+            UE_LOG(LogFMOD, Verbose, TEXT("Not writing asset table manifest, bank %s is not registered"), *BankFile.Path);
+            return;
+        }
+        BankFile.Guid = *Guid;
+    }
+
+    WriteManifest(Assets);
+}
+
+void FFMODAssetTable::WriteManifest(TArray<FAssetEntry> &Assets)
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    FString ManifestPath = GetManifestPath();
+
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*ManifestPath, FILEWRITE_Silent));
+    if (!Writer)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("Could not write asset table manifest: %s"), *ManifestPath);
+        return;
+    }
+
+    uint32 Magic = ManifestMagic;
+    int32 Version = ManifestVersion;
+    FString SettingsKey = GetManifestSettingsKey(Settings);
+
+    *Writer << Magic << Version << SettingsKey << BankFiles << Assets;
+    Writer->Close();
+}
+
+void FFMODAssetTable::GetBankFilesFromDisk(TArray<FBankFile> &OutBankFiles)
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    FString BankDir = Settings.GetFullBankPath();
+
+    TArray<FString> BankPaths;
+    GetAllBankPathsFromDisk(BankDir, BankPaths);
+    BankPaths.Sort();
+
+    OutBankFiles.Reset(BankPaths.Num());
+    for (const FString &BankPath : BankPaths)
+    {
+        FFileStatData StatData = IFileManager::Get().GetStatData(*BankPath);
+
+        FBankFile BankFile;
+        BankFile.Path = BankPath.RightChop(BankDir.Len() + 1);
+        BankFile.Size = StatData.FileSize;
+        BankFile.Timestamp = StatData.ModificationTime;
+        OutBankFiles.Add(BankFile);
+    }
+}
+
 void FFMODAssetTable::AddAsset(const FGuid &AssetGuid, const FString &AssetFullName)
 {
+    // Assets that are already known don't need to be registered again
+    const FAssetIndexEntry *ExistingEntry = AssetIndex.Find(AssetFullName);
+    if (ExistingEntry && ExistingEntry->Guid == AssetGuid)
+    {
+        const TWeakObjectPtr<UFMODAsset> *ExistingAsset = FullNameLookup.Find(AssetFullName);
+        if (bLazyAssetCreation || (ExistingAsset && ExistingAsset->IsValid()))
+        {
+            return;
+        }
+    }
+
     FString AssetPath = AssetFullName;
     FString AssetType = "";
     FString AssetFileName = "asset";
@@ -202,6 +691,81 @@ void FFMODAssetTable::AddAsset(const FGuid &AssetGuid, const FString &AssetFullN
 
     FString AssetPackagePath = FolderPath + TEXT("/") + AssetShortName;
 
+    FAssetIndexEntry Entry;
+    Entry.Guid = AssetGuid;
+    Entry.AssetClass = AssetClass;
+    Entry.FolderPath = FolderPath;
+    Entry.ShortName = AssetShortName;
+    Entry.FileName = AssetFileName;
+
+    if (AssetClass == UFMODSnapshot::StaticClass())
+    {
+        Entry.ReverbFolderPath = Settings.ContentBrowserPrefix;
+        Entry.ReverbFolderPath += TEXT("Reverbs");
+        Entry.ReverbFolderPath += AssetPath;
+
+        PackageIndex.Add(FName(*(Entry.ReverbFolderPath + TEXT("/") + AssetShortName)), AssetFullName);
+    }
+
+    PackageIndex.Add(FName(*AssetPackagePath), AssetFullName);
+    AssetIndex.Add(AssetFullName, Entry);
+    AddedAssets.Add(AssetGuid);
+
+    if (!bLazyAssetCreation)
+    {
+        MaterializeAsset(AssetFullName, Entry);
+    }
+}
+
+void FFMODAssetTable::RemoveAsset(const FString &AssetFullName)
+{
+    FAssetIndexEntry Entry;
+    if (!AssetIndex.RemoveAndCopyValue(AssetFullName, Entry))
+    {
+        return;
+    }
+
+    FString AssetPackagePath = Entry.FolderPath + TEXT("/") + Entry.ShortName;
+    PackageIndex.Remove(FName(*AssetPackagePath));
+    if (!Entry.ReverbFolderPath.IsEmpty())
+    {
+        PackageIndex.Remove(FName(*(Entry.ReverbFolderPath + TEXT("/") + Entry.ShortName)));
+    }
+    NameMap.Remove(FName(*AssetPackagePath));
+    RemovedAssets.Add(Entry.Guid);
+
+    TWeakObjectPtr<UFMODAsset> RemovedAsset;
+    FullNameLookup.RemoveAndCopyValue(AssetFullName, RemovedAsset);
+
+    UFMODAsset *AssetObject = RemovedAsset.Get();
+    if (AssetObject == nullptr)
+    {
+        return;
+    }
+
+    UE_LOG(LogFMOD, Log, TEXT("Hiding removed asset '%s'"), *AssetObject->GetPathName());
+    AssetObject->bShowAsAsset = false;
+
+    // A renamed asset has already been replaced under its guid
+    const TWeakObjectPtr<UFMODAsset> *GuidAsset = GuidMap.Find(Entry.Guid);
+    if (GuidAsset && GuidAsset->Get() == AssetObject)
+    {
+        GuidMap.Remove(Entry.Guid);
+#if WITH_EDITOR
+        FAssetRegistryModule::AssetDeleted(AssetObject);
+#endif
+    }
+}
+
+UFMODAsset *FFMODAssetTable::MaterializeAsset(const FString &AssetFullName, const FAssetIndexEntry &Entry)
+{
+    const FGuid &AssetGuid = Entry.Guid;
+    UClass *AssetClass = Entry.AssetClass;
+    const FString &FolderPath = Entry.FolderPath;
+    const FString &AssetShortName = Entry.ShortName;
+    const FString &AssetFileName = Entry.FileName;
+    FString AssetPackagePath = FolderPath + TEXT("/") + AssetShortName;
+
     FName AssetPackagePathName(*AssetPackagePath);
 
     TWeakObjectPtr<UFMODAsset> &ExistingNameAsset = NameMap.FindOrAdd(AssetPackagePathName);
@@ -245,9 +809,7 @@ void FFMODAssetTable::AddAsset(const FGuid &AssetGuid, const FString &AssetFullN
 
         if (AssetClass == UFMODSnapshot::StaticClass())
         {
-            FString ReverbFolderPath = Settings.ContentBrowserPrefix;
-            ReverbFolderPath += TEXT("Reverbs");
-            ReverbFolderPath += AssetPath;
+            const FString &ReverbFolderPath = Entry.ReverbFolderPath;
 
             FString ReverbAssetPackagePath = ReverbFolderPath + TEXT("/") + AssetShortName;
 
@@ -290,6 +852,113 @@ void FFMODAssetTable::AddAsset(const FGuid &AssetGuid, const FString &AssetFullN
     ExistingNameAsset = AssetNameObject;
     ExistingGuidAsset = AssetNameObject;
     ExistingFullNameLookupAsset = AssetNameObject;
+
+    return AssetNameObject;
+}
+
+UFMODAsset *FFMODAssetTable::FindByPath(const FSoftObjectPath &Path)
+{
+    const FString *AssetFullName = PackageIndex.Find(FName(*Path.GetLongPackageName()));
+    if (!AssetFullName || !FindByName(*AssetFullName))
+    {
+        return nullptr;
+    }
+
+    // Snapshot reverbs are constructed along with their snapshot, so look the object up by its own path
+    return FindObject<UFMODAsset>(nullptr, *Path.ToString());
+}
+
+void FFMODAssetTable::GetBanksContainingEvents(const TSet<FGuid> &EventGuids, TArray<UFMODBank *> &OutBanks)
+{
+    if (!bActive)
+    {
+        return;
+    }
+
+    if (!bEventBankLookupValid)
+    {
+        BuildEventBankLookup();
+    }
+
+    TSet<FGuid> BankGuids;
+    for (const FGuid &EventGuid : EventGuids)
+    {
+        if (const TArray<FGuid> *EventBanks = EventBankLookup.Find(EventGuid))
+        {
+            BankGuids.Append(*EventBanks);
+        }
+    }
+
+    for (const FGuid &BankGuid : BankGuids)
+    {
+        UFMODBank *Bank = nullptr;
+        if (const TWeakObjectPtr<UFMODAsset> *Asset = GuidMap.Find(BankGuid))
+        {
+            Bank = Cast<UFMODBank>(Asset->Get());
+        }
+
+        if (Bank == nullptr)
+        {
+            // Assets that are created lazily may not have been constructed yet
+            for (const TMap<FString, FAssetIndexEntry>::ElementType &Entry : AssetIndex)
+            {
+                if (Entry.Value.Guid == BankGuid)
+                {
+                    Bank = Cast<UFMODBank>(FindByName(Entry.Key));
+                    break;
+                }
+            }
+        }
+
+        if (Bank)
+        {
+            OutBanks.Add(Bank);
+        }
+    }
+}
+
+void FFMODAssetTable::BuildEventBankLookup()
+{
+    EventBankLookup.Reset();
+
+    TArray<FString> BankPaths;
+    GetAllBankPaths(BankPaths, true);
+
+    UE_LOG(LogFMOD, Log, TEXT("Finding the events in %d banks"), BankPaths.Num());
+
+    for (const FString &BankPath : BankPaths)
+    {
+        // Only the metadata is loaded, so this doesn't need the master bank or any sample data
+        FMOD::Studio::Bank *Bank = nullptr;
+        if (GetStudioSystem()->loadBankFile(TCHAR_TO_UTF8(*BankPath), FMOD_STUDIO_LOAD_BANK_NORMAL, &Bank) != FMOD_OK)
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to load bank to find its events: %s"), *BankPath);
+            continue;
+        }
+
+        FMOD::Studio::ID BankID;
+        int EventCount = 0;
+        if (Bank->getID(&BankID) == FMOD_OK && Bank->getEventCount(&EventCount) == FMOD_OK && EventCount > 0)
+        {
+            TArray<FMOD::Studio::EventDescription *> Events;
+            Events.SetNumUninitialized(EventCount);
+            verifyfmod(Bank->getEventList(Events.GetData(), EventCount, &EventCount));
+
+            for (int i = 0; i < EventCount; ++i)
+            {
+                FMOD::Studio::ID EventID;
+                if (Events[i]->getID(&EventID) == FMOD_OK)
+                {
+                    EventBankLookup.FindOrAdd(FMODUtils::ConvertGuid(EventID)).AddUnique(FMODUtils::ConvertGuid(BankID));
+                }
+            }
+        }
+
+        Bank->unload();
+        StudioSystem->flushCommands();
+    }
+
+    bEventBankLookupValid = true;
 }
 
 FString FFMODAssetTable::GetBankPathByGuid(const FGuid& Guid) const
@@ -407,7 +1076,10 @@ void FFMODAssetTable::BuildBankPathLookup()
     const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
 
     TArray<FString> BankPaths;
-    GetAllBankPathsFromDisk(Settings.GetFullBankPath(), BankPaths);
+    for (const FBankFile &BankFile : BankFiles)
+    {
+        BankPaths.Add(Settings.GetFullBankPath() / BankFile.Path);
+    }
 
     BankPathLookup.Empty(BankPaths.Num());
     MasterBankPath.Empty();
@@ -419,62 +1091,141 @@ void FFMODAssetTable::BuildBankPathLookup()
         return;
     }
 
-    for (FString BankPath : BankPaths)
+    // Scan the bank headers in parallel, only falling back to FMOD for banks we could not parse
+    TArray<FGuid> BankGuids;
+    BankGuids.SetNum(BankPaths.Num());
+    ParallelFor(BankPaths.Num(), [&BankPaths, &BankGuids](int32 Index) {
+        if (!ReadBankGuidFromHeader(BankPaths[Index], BankGuids[Index]))
+        {
+            BankGuids[Index].Invalidate();
+        }
+    });
+
+    for (int32 Index = 0; Index < BankPaths.Num(); ++Index)
     {
-        FMOD::Studio::Bank *Bank;
-        FMOD_RESULT result = StudioSystem->loadBankFile(TCHAR_TO_UTF8(*BankPath), FMOD_STUDIO_LOAD_BANK_NORMAL, &Bank);
-        FMOD_GUID GUID;
+        FGuid &Guid = BankGuids[Index];
 
-        if (result == FMOD_OK)
+        if (!Guid.IsValid())
         {
-            result = Bank->getID(&GUID);
-            Bank->unload();
+            UE_LOG(LogFMOD, Verbose, TEXT("Could not read bank header, loading bank to find its GUID: %s"), *BankPaths[Index]);
+            LoadBankGuid(BankPaths[Index], Guid);
         }
 
-        if (result == FMOD_OK)
+        if (Guid.IsValid())
+        {
+            AddBankPath(Guid, BankPaths[Index]);
+        }
+        else
         {
-            FString CurFilename = FPaths::GetCleanFilename(BankPath);
-            FString PathPart;
-            FString FilenamePart;
-            FString ExtensionPart;
-            FPaths::Split(BankPath, PathPart, FilenamePart, ExtensionPart);
-            BankPath = BankPath.RightChop(Settings.GetFullBankPath().Len() + 1);
+            UE_LOG(LogFMOD, Error, TEXT("Failed to register disk file for bank: %s"), *BankPaths[Index]);
+        }
+    }
+}
 
-            BankLocalization localization;
-            localization.Path = BankPath;
-            localization.Locale = "";
+bool FFMODAssetTable::LoadBankGuid(const FString &BankPath, FGuid &OutGuid)
+{
+    FMOD::Studio::Bank *Bank;
+    FMOD_RESULT result = GetStudioSystem()->loadBankFile(TCHAR_TO_UTF8(*BankPath), FMOD_STUDIO_LOAD_BANK_NORMAL, &Bank);
+    FMOD_GUID GUID;
 
-            for (const FFMODProjectLocale& Locale : Settings.Locales)
-            {
-                if (FilenamePart.EndsWith(FString("_") + Locale.LocaleCode))
-                {
-                    localization.Locale = Locale.LocaleCode;
-                    break;
-                }
-            }
+    if (result == FMOD_OK)
+    {
+        result = Bank->getID(&GUID);
+        Bank->unload();
+        StudioSystem->flushCommands();
+    }
 
-            BankLocalizations& localizations = BankPathLookup.FindOrAdd(FMODUtils::ConvertGuid(GUID));
-            localizations.Add(localization);
+    if (result == FMOD_OK)
+    {
+        OutGuid = FMODUtils::ConvertGuid(GUID);
+        return true;
+    }
 
-            if (MasterBankPath.IsEmpty() && CurFilename == Settings.GetMasterBankFilename())
-            {
-                MasterBankPath = BankPath;
-            }
-            else if (MasterStringsBankPath.IsEmpty() && CurFilename == Settings.GetMasterStringsBankFilename())
-            {
-                MasterStringsBankPath = BankPath;
-            }
-            else if (MasterAssetsBankPath.IsEmpty() && CurFilename == Settings.GetMasterAssetsBankFilename())
-            {
-                MasterAssetsBankPath = BankPath;
-            }
+    return false;
+}
+
+void FFMODAssetTable::AddBankPath(const FGuid &Guid, const FString &FullBankPath)
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+
+    FString CurFilename = FPaths::GetCleanFilename(FullBankPath);
+    FString PathPart;
+    FString FilenamePart;
+    FString ExtensionPart;
+    FPaths::Split(FullBankPath, PathPart, FilenamePart, ExtensionPart);
+    FString BankPath = FullBankPath.RightChop(Settings.GetFullBankPath().Len() + 1);
+
+    BankLocalization localization;
+    localization.Path = BankPath;
+    localization.Locale = "";
+
+    for (const FFMODProjectLocale& Locale : Settings.Locales)
+    {
+        if (FilenamePart.EndsWith(FString("_") + Locale.LocaleCode))
+        {
+            localization.Locale = Locale.LocaleCode;
+            break;
         }
+    }
+
+    BankLocalizations& localizations = BankPathLookup.FindOrAdd(Guid);
+    localizations.Add(localization);
+
+    if (MasterBankPath.IsEmpty() && CurFilename == Settings.GetMasterBankFilename())
+    {
+        MasterBankPath = BankPath;
+    }
+    else if (MasterStringsBankPath.IsEmpty() && CurFilename == Settings.GetMasterStringsBankFilename())
+    {
+        MasterStringsBankPath = BankPath;
+    }
+    else if (MasterAssetsBankPath.IsEmpty() && CurFilename == Settings.GetMasterAssetsBankFilename())
+    {
+        MasterAssetsBankPath = BankPath;
+    }
+}
+
+void FFMODAssetTable::ValidateBankPathLookup(const TSet<FGuid> &KnownBankGuids)
+{
+    if (KnownBankGuids.Num() == 0)
+    {
+        return;
+    }
 
-        if (result != FMOD_OK)
+    // A GUID the strings bank doesn't know about means the header didn't parse as expected, so ask FMOD instead
+    TArray<FGuid> UnknownGuids;
+    for (const TMap<FGuid, BankLocalizations>::ElementType &Localizations : BankPathLookup)
+    {
+        if (!KnownBankGuids.Contains(Localizations.Key))
         {
-            UE_LOG(LogFMOD, Error, TEXT("Failed to register disk file for bank: %s"), *BankPath);
+            UnknownGuids.Add(Localizations.Key);
         }
     }
 
-    StudioSystem->flushCommands();
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+
+    for (const FGuid &UnknownGuid : UnknownGuids)
+    {
+        BankLocalizations Localizations;
+        BankPathLookup.RemoveAndCopyValue(UnknownGuid, Localizations);
+
+        for (const BankLocalization &Localization : Localizations)
+        {
+            FString FullBankPath = Settings.GetFullBankPath() / Localization.Path;
+            FGuid Guid;
+
+            if (LoadBankGuid(FullBankPath, Guid))
+            {
+                if (Guid != UnknownGuid)
+                {
+                    UE_LOG(LogFMOD, Verbose, TEXT("Bank header GUID did not match for %s"), *FullBankPath);
+                }
+                BankPathLookup.FindOrAdd(Guid).Add(Localization);
+            }
+            else
+            {
+                UE_LOG(LogFMOD, Error, TEXT("Failed to register disk file for bank: %s"), *FullBankPath);
+            }
+        }
+    }
 }
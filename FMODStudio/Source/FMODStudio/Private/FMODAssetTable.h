@@ -3,6 +3,9 @@
 #pragma once
 
 #include "FMODAsset.h"
+#include "Misc/DateTime.h"
+#include "Misc/SecureHash.h"
+#include "UObject/SoftObjectPath.h"
 
 namespace FMOD
 {
@@ -25,8 +28,11 @@ public:
     void Destroy();
 
     void Refresh();
+    bool GetChangedBankFiles(TArray<FString> &OutChangedBankFiles) const;
+    void GetAssetChanges(TArray<FGuid> &OutAddedAssets, TArray<FGuid> &OutRemovedAssets) const;
 
-    UFMODAsset *FindByName(const FString &Name) const;
+    UFMODAsset *FindByName(const FString &Name);
+    UFMODAsset *FindByPath(const FSoftObjectPath &Path);
     FString GetBankPath(const UFMODBank &Bank) const;
     FString GetMasterBankPath() const;
     FString GetMasterStringsBankPath() const;
@@ -34,14 +40,60 @@ public:
     void SetLocale(const FString &LocaleCode);
     void GetAllBankPaths(TArray<FString> &BankPaths, bool IncludeMasterBank) const;
 
+    /** Find the banks containing any of the given events by loading each bank's metadata into the sandbox system */
+    void GetBanksContainingEvents(const TSet<FGuid> &EventGuids, TArray<UFMODBank *> &OutBanks);
+
+    /** A bank file on disk as recorded in the asset table manifest. */
+    struct FBankFile
+    {
+        FString Path;
+        int64 Size;
+        FDateTime Timestamp;
+        FMD5Hash Hash;
+        FGuid Guid;
+    };
+
+    struct FAssetEntry
+    {
+        FGuid Guid;
+        FString FullName;
+    };
+
 private:
+    /** Everything needed to construct an asset object on demand. */
+    struct FAssetIndexEntry
+    {
+        FGuid Guid;
+        UClass *AssetClass;
+        FString FolderPath;
+        FString ReverbFolderPath;
+        FString ShortName;
+        FString FileName;
+    };
+
+    FMOD::Studio::System *GetStudioSystem();
+    UFMODAsset *MaterializeAsset(const FString &AssetFullName, const FAssetIndexEntry &Entry);
     void AddAsset(const FGuid &AssetGuid, const FString &AssetFullName);
+    void RemoveAsset(const FString &AssetFullName);
     void GetAllBankPathsFromDisk(const FString &BankDir, TArray<FString> &Paths);
     void BuildBankPathLookup();
+    bool LoadBankGuid(const FString &BankPath, FGuid &OutGuid);
+    void AddBankPath(const FGuid &Guid, const FString &FullBankPath);
+    void ValidateBankPathLookup(const TSet<FGuid> &KnownBankGuids);
+    void GetBankFilesFromDisk(TArray<FBankFile> &OutBankFiles);
+    bool ResolveBankFiles(const TArray<FBankFile> &ManifestBankFiles, bool bRequireMatch);
+    bool LoadManifest(TArray<FBankFile> &OutManifestBankFiles);
+    void SaveManifest(const TArray<FBankFile> &PreviousBankFiles, TArray<FAssetEntry> &Assets);
+    void WriteManifest(TArray<FAssetEntry> &Assets);
     FString GetBankPathByGuid(const FGuid& Guid) const;
+    void BuildEventBankLookup();
 
 private:
     FMOD::Studio::System *StudioSystem;
+    bool bActive;
+    bool bLazyAssetCreation;
+    TMap<FString, FAssetIndexEntry> AssetIndex;
+    TMap<FName, FString> PackageIndex;
     TMap<FGuid, TWeakObjectPtr<UFMODAsset>> GuidMap;
     TMap<FName, TWeakObjectPtr<UFMODAsset>> NameMap;
     TMap<FString, TWeakObjectPtr<UFMODAsset>> FullNameLookup;
@@ -58,5 +110,13 @@ private:
     typedef TArray<BankLocalization> BankLocalizations;
 
     TMap<FGuid, BankLocalizations> BankPathLookup;
+    TArray<FBankFile> BankFiles;
+    TArray<FBankFile> LastBankFiles;
+    TArray<FGuid> AddedAssets;
+    TArray<FGuid> RemovedAssets;
     FString ActiveLocale;
+
+    /** Banks containing each event, built on first use and thrown away whenever the banks are refreshed */
+    TMap<FGuid, TArray<FGuid>> EventBankLookup;
+    bool bEventBankLookupValid;
 };
@@ -6,7 +6,15 @@
 #include "FMODEvent.h"
 #include "FMODListener.h"
 #include "FMODSettings.h"
+#include "FMODCommandBuffer.h"
+#include "FMODEmitterManager.h"
+#include "FMODEventDescriptionCache.h"
+#include "FMODSignificanceManager.h"
+#include "FMODOcclusionManager.h"
+#include "FMODPlaybackCompletionQueue.h"
+#include "FMODProgrammerSoundCache.h"
 #include "fmod_studio.hpp"
+#include "fmod_errors.h"
 #include "Misc/App.h"
 #include "Misc/Paths.h"
 #include "Misc/ScopeLock.h"
@@ -16,12 +24,16 @@
 #include "Engine/Texture2D.h"
 #endif
 
+// Room for timeline callbacks received between two ticks of a component
+static const uint32 TimelineCallbackQueueSize = 256;
+
 UFMODAudioComponent::UFMODAudioComponent(const FObjectInitializer &ObjectInitializer)
     : Super(ObjectInitializer)
 {
     bAutoDestroy = false;
     bAutoActivate = true;
     bEnableTimelineCallbacks = false; // Default OFF for efficiency
+    bAllowVirtualization = true;
     bStopWhenOwnerDestroyed = true;
     bNeverNeedsRenderUpdate = true;
     bWantsOnUpdateTransform = true;
@@ -41,7 +53,14 @@ UFMODAudioComponent::UFMODAudioComponent(const FObjectInitializer &ObjectInitial
     LastLPF = MAX_FILTER_FREQUENCY;
     LastVolume = 1.0f;
     Module = nullptr;
-    wasOccluded = false;
+    OcclusionTarget = 0.0f;
+    OcclusionCurrent = -1.0f;
+    bTransformDirty = false;
+    bVirtual = false;
+    bPlayQueued = false;
+    VirtualTimelinePosition = 0;
+    VirtualStartTime = 0.0f;
+    EventMaximumDistance = 0.0f;
 
     for (int i = 0; i < EFMODEventProperty::Count; ++i)
     {
@@ -125,13 +144,36 @@ void UFMODAudioComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransfor
     Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
     if (StudioInstance)
     {
-        FMOD_3D_ATTRIBUTES attr = { { 0 } };
-        attr.position = FMODUtils::ConvertWorldVector(GetComponentTransform().GetLocation());
-        attr.up = FMODUtils::ConvertUnitVector(GetComponentTransform().GetUnitAxis(EAxis::Z));
-        attr.forward = FMODUtils::ConvertUnitVector(GetComponentTransform().GetUnitAxis(EAxis::X));
-        attr.velocity = FMODUtils::ConvertWorldVector(GetOwner()->GetVelocity());
+        if (GetDefault<UFMODSettings>()->bBatch3DAttributes)
+        {
+            // Submitted along with every other moved emitter just before the next Studio update
+            FFMODEmitterManager::Get().MarkDirty(this);
+        }
+        else
+        {
+            Update3DAttributes();
+        }
+    }
+}
+
+void UFMODAudioComponent::Update3DAttributes()
+{
+    LastSubmittedTransform = GetComponentTransform();
+
+    FVector Velocity = GetOwner() ? GetOwner()->GetVelocity() : FVector::ZeroVector;
+    FMOD_3D_ATTRIBUTES attr = { { 0 } };
+    FFMODEmitterManager::ConvertAttributes(&LastSubmittedTransform, &Velocity, &attr, 1);
 
-        StudioInstance->set3DAttributes(&attr);
+    Apply3DAttributes(attr);
+}
+
+void UFMODAudioComponent::Apply3DAttributes(const FMOD_3D_ATTRIBUTES &Attributes)
+{
+    bTransformDirty = false;
+
+    if (StudioInstance)
+    {
+        FFMODCommandBuffer::Get().Set3DAttributes(StudioInstance, Attributes);
 
         UpdateInteriorVolumes();
         UpdateAttenuation();
@@ -232,32 +274,24 @@ void UFMODAudioComponent::UpdateAttenuation()
         return;
     }
 
+    // Stored properties are reapplied whenever a new instance is created, so only changes need to be sent
     if (AttenuationDetails.bOverrideAttenuation)
     {
-        SetProperty(EFMODEventProperty::MinimumDistance, AttenuationDetails.MinimumDistance);
-        SetProperty(EFMODEventProperty::MaximumDistance, AttenuationDetails.MaximumDistance);
+        if (StoredProperties[EFMODEventProperty::MinimumDistance] != AttenuationDetails.MinimumDistance)
+        {
+            SetProperty(EFMODEventProperty::MinimumDistance, AttenuationDetails.MinimumDistance);
+        }
+        if (StoredProperties[EFMODEventProperty::MaximumDistance] != AttenuationDetails.MaximumDistance)
+        {
+            SetProperty(EFMODEventProperty::MaximumDistance, AttenuationDetails.MaximumDistance);
+        }
     }
 
     // Use occlusion part of settings
     if (OcclusionDetails.bEnableOcclusion && bApplyOcclusionParameter)
     {
-        static FName NAME_SoundOcclusion = FName(TEXT("SoundOcclusion"));
-        FCollisionQueryParams Params(NAME_SoundOcclusion, OcclusionDetails.bUseComplexCollisionForOcclusion, GetOwner());
-
-        const FVector &Location = GetOwner()->GetTransform().GetTranslation();
-        const FFMODListener &Listener = GetStudioModule().GetNearestListener(Location);
-
-        bool bIsOccluded = GWorld->LineTraceTestByChannel(Location, Listener.Transform.GetLocation(), OcclusionDetails.OcclusionTraceChannel, Params);
-
-        if (bIsOccluded != wasOccluded)
-        {
-            StudioInstance->setParameterByID(OcclusionID, bIsOccluded ? 1.0f : 0.0f);
-            wasOccluded = bIsOccluded;
-        }
-    }
-    else
-    {
-        wasOccluded = false;
+        // Traced asynchronously and applied to the occlusion parameter as results come in
+        FFMODOcclusionManager::Get().Register(this);
     }
 }
 
@@ -268,14 +302,14 @@ void UFMODAudioComponent::ApplyVolumeLPF()
         float CurVolume = AmbientVolume;
         if (CurVolume != LastVolume)
         {
-            StudioInstance->setParameterByID(AmbientVolumeID, CurVolume);
+            FFMODCommandBuffer::Get().SetParameterByID(StudioInstance, AmbientVolumeID, CurVolume);
             LastVolume = CurVolume;
         }
 
         float CurLPF = AmbientLPF;
         if (CurLPF != LastLPF)
         {
-            StudioInstance->setParameterByID(AmbientLPFID, CurLPF);
+            FFMODCommandBuffer::Get().SetParameterByID(StudioInstance, AmbientLPFID, CurLPF);
             LastLPF = CurLPF;
         }
     }
@@ -351,37 +385,38 @@ void UFMODAudioComponent::TickComponent(float DeltaTime, enum ELevelTick TickTyp
 
     if (IsActive())
     {
-        if (GetStudioModule().HasListenerMoved())
+        if (StudioInstance && GetStudioModule().HasListenerMoved())
         {
             UpdateInteriorVolumes();
             UpdateAttenuation();
             ApplyVolumeLPF();
         }
 
-        if (bEnableTimelineCallbacks)
+        if (TimelineCallbackQueue.IsValid())
         {
-            TArray<FTimelineMarkerProperties> LocalMarkerQueue;
-            TArray<FTimelineBeatProperties> LocalBeatQueue;
+            FTimelineCallbackProperties EachProps;
+            while (TimelineCallbackQueue->Dequeue(EachProps))
             {
-                FScopeLock Lock(&CallbackLock);
-                Swap(LocalMarkerQueue, CallbackMarkerQueue);
-                Swap(LocalBeatQueue, CallbackBeatQueue);
+                if (EachProps.bIsMarker)
+                {
+                    OnTimelineMarker.Broadcast(FString(UTF8_TO_TCHAR(EachProps.MarkerName)), EachProps.MarkerPosition);
+                }
+                else
+                {
+                    const FTimelineBeatProperties &Beat = EachProps.Beat;
+                    OnTimelineBeat.Broadcast(Beat.Bar, Beat.Beat, Beat.Position, Beat.Tempo, Beat.TimeSignatureUpper, Beat.TimeSignatureLower);
+                }
             }
 
-            for (const FTimelineMarkerProperties &EachProps : LocalMarkerQueue)
-            {
-                OnTimelineMarker.Broadcast(EachProps.Name, EachProps.Position);
-            }
-            for (const FTimelineBeatProperties &EachProps : LocalBeatQueue)
+            const int32 Dropped = DroppedTimelineCallbacks.Reset();
+            if (Dropped > 0)
             {
-                OnTimelineBeat.Broadcast(
-                    EachProps.Bar, EachProps.Beat, EachProps.Position, EachProps.Tempo, EachProps.TimeSignatureUpper, EachProps.TimeSignatureLower);
+                UE_LOG(LogFMOD, Warning, TEXT("UFMODAudioComponent %p dropped %d timeline callbacks"), this, Dropped);
             }
         }
 
-        FMOD_STUDIO_PLAYBACK_STATE state = FMOD_STUDIO_PLAYBACK_STOPPED;
-        StudioInstance->getPlaybackState(&state);
-        if (state == FMOD_STUDIO_PLAYBACK_STOPPED)
+        // Normally completion comes from the stopped callback, but an instance can also go away with its bank or system
+        if (!StudioInstance || !StudioInstance->isValid())
         {
             OnPlaybackCompleted();
         }
@@ -409,6 +444,12 @@ void UFMODAudioComponent::SetEvent(UFMODEvent *NewEvent)
 void UFMODAudioComponent::PostLoad()
 {
     Super::PostLoad();
+
+    // Make sure the event asset exists when assets are created on demand
+    if (!Event.IsNull() && !Event.IsValid())
+    {
+        GetStudioModule().FindAssetByPath(Event.ToSoftObjectPath());
+    }
 }
 
 void UFMODAudioComponent::Activate(bool bReset)
@@ -433,6 +474,14 @@ FMOD_RESULT F_CALLBACK UFMODAudioComponent_EventCallback(FMOD_STUDIO_EVENT_CALLB
 {
     UFMODAudioComponent *Component = nullptr;
     FMOD::Studio::EventInstance *Instance = (FMOD::Studio::EventInstance *)event;
+
+    if (type == FMOD_STUDIO_EVENT_CALLBACK_STOPPED)
+    {
+        // Completion is handled on the game thread
+        FFMODPlaybackCompletionQueue::Get().Post(Instance);
+        return FMOD_OK;
+    }
+
     if (Instance->getUserData((void **)&Component) == FMOD_OK && IsValid(Component))
     {
         if (type == FMOD_STUDIO_EVENT_CALLBACK_TIMELINE_MARKER && Component->bEnableTimelineCallbacks)
@@ -459,9 +508,12 @@ void UFMODAudioComponent_ReleaseProgrammerSound(FMOD_STUDIO_PROGRAMMER_SOUND_PRO
 {
     if (props->sound)
     {
-        UE_LOG(LogFMOD, Verbose, TEXT("Destroying programmer sound"));
-        FMOD_RESULT Result = ((FMOD::Sound *)props->sound)->release();
-        verifyfmod(Result);
+        if (!FFMODProgrammerSoundCache::Get().Release((FMOD::Sound *)props->sound))
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT("Destroying programmer sound"));
+            FMOD_RESULT Result = ((FMOD::Sound *)props->sound)->release();
+            verifyfmod(Result);
+        }
     }
 }
 
@@ -473,24 +525,29 @@ FMOD_RESULT F_CALLBACK UFMODAudioComponent_EventCallbackDestroyProgrammerSound(F
 
 void UFMODAudioComponent::EventCallbackAddMarker(FMOD_STUDIO_TIMELINE_MARKER_PROPERTIES *props)
 {
-    FScopeLock Lock(&CallbackLock);
-    FTimelineMarkerProperties info;
-    info.Name = props->name;
-    info.Position = props->position;
-    CallbackMarkerQueue.Push(info);
+    FTimelineCallbackProperties info = {};
+    info.bIsMarker = true;
+    FCStringAnsi::Strncpy(info.MarkerName, props->name ? props->name : "", FTimelineCallbackProperties::MaxMarkerNameLength);
+    info.MarkerPosition = props->position;
+    if (!TimelineCallbackQueue.IsValid() || !TimelineCallbackQueue->Enqueue(info))
+    {
+        DroppedTimelineCallbacks.Increment();
+    }
 }
 
 void UFMODAudioComponent::EventCallbackAddBeat(FMOD_STUDIO_TIMELINE_BEAT_PROPERTIES *props)
 {
-    FScopeLock Lock(&CallbackLock);
-    FTimelineBeatProperties info;
-    info.Bar = props->bar;
-    info.Beat = props->beat;
-    info.Position = props->position;
-    info.Tempo = props->tempo;
-    info.TimeSignatureUpper = props->timesignatureupper;
-    info.TimeSignatureLower = props->timesignaturelower;
-    CallbackBeatQueue.Push(info);
+    FTimelineCallbackProperties info = {};
+    info.Beat.Bar = props->bar;
+    info.Beat.Beat = props->beat;
+    info.Beat.Position = props->position;
+    info.Beat.Tempo = props->tempo;
+    info.Beat.TimeSignatureUpper = props->timesignatureupper;
+    info.Beat.TimeSignatureLower = props->timesignaturelower;
+    if (!TimelineCallbackQueue.IsValid() || !TimelineCallbackQueue->Enqueue(info))
+    {
+        DroppedTimelineCallbacks.Increment();
+    }
 }
 
 void UFMODAudioComponent::EventCallbackCreateProgrammerSound(FMOD_STUDIO_PROGRAMMER_SOUND_PROPERTIES *props)
@@ -510,59 +567,16 @@ void UFMODAudioComponent::EventCallbackCreateProgrammerSound(FMOD_STUDIO_PROGRAM
     else if (ProgrammerSoundNameCopy.Len() || strlen(props->name) != 0)
     {
         FMOD::Studio::System *System = GetStudioModule().GetStudioSystem(EFMODSystemContext::Max);
-        FMOD::System *LowLevelSystem = nullptr;
-        System->getCoreSystem(&LowLevelSystem);
         FString SoundName = ProgrammerSoundNameCopy.Len() ? ProgrammerSoundNameCopy : UTF8_TO_TCHAR(props->name);
-        FMOD_MODE SoundMode = FMOD_LOOP_NORMAL | FMOD_CREATECOMPRESSEDSAMPLE | FMOD_NONBLOCKING;
 
-        if (SoundName.Contains(TEXT(".")))
+        // Shared with other instruments playing the same line, and kept around for a while after they finish
+        int32 SubsoundIndex = -1;
+        FMOD::Sound *Sound = FFMODProgrammerSoundCache::Get().Acquire(System, SoundName, SubsoundIndex);
+        if (Sound)
         {
-            // Load via file
-            FString SoundPath = SoundName;
-            if (FPaths::IsRelative(SoundPath))
-            {
-                SoundPath = FPaths::ProjectContentDir() / SoundPath;
-            }
-
-            FMOD::Sound *Sound = nullptr;
-            if (LowLevelSystem->createSound(TCHAR_TO_UTF8(*SoundPath), SoundMode, nullptr, &Sound) == FMOD_OK)
-            {
-                UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound from file '%s'"), *SoundPath);
-                props->sound = (FMOD_SOUND *)Sound;
-                props->subsoundIndex = -1;
-                NeedDestroyProgrammerSoundCallback = true;
-            }
-            else
-            {
-                UE_LOG(LogFMOD, Warning, TEXT("Failed to load programmer sound file '%s'"), *SoundPath);
-            }
-        }
-        else
-        {
-            // Load via FMOD Studio asset table
-            FMOD_STUDIO_SOUND_INFO SoundInfo = { 0 };
-            FMOD_RESULT Result = System->getSoundInfo(TCHAR_TO_UTF8(*SoundName), &SoundInfo);
-            if (Result == FMOD_OK)
-            {
-                FMOD::Sound *Sound = nullptr;
-                Result = LowLevelSystem->createSound(SoundInfo.name_or_data, SoundMode | SoundInfo.mode, &SoundInfo.exinfo, &Sound);
-                if (Result == FMOD_OK)
-                {
-                    UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound using audio entry '%s'"), *SoundName);
-
-                    props->sound = (FMOD_SOUND *)Sound;
-                    props->subsoundIndex = SoundInfo.subsoundindex;
-                    NeedDestroyProgrammerSoundCallback = true;
-                }
-                else
-                {
-                    UE_LOG(LogFMOD, Warning, TEXT("Failed to load FMOD audio entry '%s'"), *SoundName);
-                }
-            }
-            else
-            {
-                UE_LOG(LogFMOD, Warning, TEXT("Failed to find FMOD audio entry '%s'"), *SoundName);
-            }
+            props->sound = (FMOD_SOUND *)Sound;
+            props->subsoundIndex = SubsoundIndex;
+            NeedDestroyProgrammerSoundCallback = true;
         }
     }
 }
@@ -595,6 +609,7 @@ void UFMODAudioComponent::Play()
 
 void UFMODAudioComponent::PlayInternal(EFMODSystemContext::Type Context)
 {
+    const bool bWasPlayQueued = bPlayQueued;
     Stop();
 
     if (!FMODUtils::IsWorldAudible(GetWorld(), Context == EFMODSystemContext::Editor))
@@ -602,13 +617,32 @@ void UFMODAudioComponent::PlayInternal(EFMODSystemContext::Type Context)
         return;
     }
 
+    if (Context != EFMODSystemContext::Editor && !GetStudioModule().IsSystemReady())
+    {
+        // Stop clears the flag, so a component stopped before the system is ready stays silent
+        bPlayQueued = true;
+        if (!bWasPlayQueued)
+        {
+            TWeakObjectPtr<UFMODAudioComponent> WeakThis = this;
+            GetStudioModule().QueueUntilReady([WeakThis, Context]() {
+                if (WeakThis.IsValid() && WeakThis->bPlayQueued && WeakThis->IsRegistered())
+                {
+                    WeakThis->PlayInternal(Context);
+                }
+            });
+        }
+        return;
+    }
+
     UE_LOG(LogFMOD, Verbose, TEXT("UFMODAudioComponent %p Play"), this);
 
     // Only play events in PIE/game, not when placing them in the editor
     FMOD::Studio::EventDescription *EventDesc = GetStudioModule().GetEventDescription(Event.Get(), Context);
     if (EventDesc != nullptr)
     {
-        EventDesc->getLength(&EventLength);
+        EventInfo = FFMODEventDescriptionCache::Get().Find(EventDesc);
+        EventLength = EventInfo->Length;
+        EventMaximumDistance = EventInfo->MaximumDistance;
         if (!StudioInstance || !StudioInstance->isValid())
         {
             FMOD_RESULT result = EventDesc->createInstance(&StudioInstance);
@@ -617,49 +651,75 @@ void UFMODAudioComponent::PlayInternal(EFMODSystemContext::Type Context)
         }
 
         const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
-        FMOD_STUDIO_PARAMETER_DESCRIPTION paramDesc = {};
-        FString param = Settings.OcclusionParameter;
-        if (!param.IsEmpty())
+        const FMOD_STUDIO_PARAMETER_ID *ParamId = nullptr;
+        if (!Settings.OcclusionParameter.IsEmpty())
         {
-            if (EventDesc->getParameterDescriptionByName(TCHAR_TO_UTF8(*Settings.OcclusionParameter), &paramDesc) == FMOD_OK)
+            ParamId = EventInfo->FindParameterId(FName(*Settings.OcclusionParameter));
+            if (ParamId)
             {
-                OcclusionID = paramDesc.id;
+                OcclusionID = *ParamId;
                 bApplyOcclusionParameter = true;
             }
         }
 
-        paramDesc = {};
-        param = Settings.AmbientVolumeParameter;
-        if (!param.IsEmpty())
+        if (!Settings.AmbientVolumeParameter.IsEmpty())
         {
-            if (EventDesc->getParameterDescriptionByName(TCHAR_TO_UTF8(*param), &paramDesc) == FMOD_OK)
+            ParamId = EventInfo->FindParameterId(FName(*Settings.AmbientVolumeParameter));
+            if (ParamId)
             {
-                AmbientVolumeID = paramDesc.id;
+                AmbientVolumeID = *ParamId;
                 bApplyAmbientVolumes = true;
             }
         }
 
-        paramDesc = {};
-        param = Settings.AmbientLPFParameter;
-        if (!param.IsEmpty())
+        if (!Settings.AmbientLPFParameter.IsEmpty())
         {
-            if (EventDesc->getParameterDescriptionByName(TCHAR_TO_UTF8(*Settings.AmbientLPFParameter), &paramDesc) == FMOD_OK)
+            ParamId = EventInfo->FindParameterId(FName(*Settings.AmbientLPFParameter));
+            if (ParamId)
             {
-                AmbientLPFID = paramDesc.id;
+                AmbientLPFID = *ParamId;
                 bApplyAmbientVolumes = true;
             }
         }
 
-        OnUpdateTransform(EUpdateTransformFlags::SkipPhysicsUpdate);
+        // Always position the instance before it starts, even when moves are batched
+        Update3DAttributes();
         // Set initial parameters
-        for (auto Kvp : ParameterCache)
+        TArray<FMOD_STUDIO_PARAMETER_ID, TInlineAllocator<16>> InitialParamIds;
+        TArray<float, TInlineAllocator<16>> InitialParamValues;
+        TArray<FName, TInlineAllocator<16>> InitialParamNames;
+        for (const TPair<FName, float> &Kvp : ParameterCache)
         {
-            FMOD_RESULT Result = StudioInstance->setParameterByName(TCHAR_TO_UTF8(*Kvp.Key.ToString()), Kvp.Value);
-            if (Result != FMOD_OK)
+            // One parameter that can't be set would fail the whole batch
+            ParamId = EventInfo->FindParameterId(Kvp.Key);
+            if (ParamId && EventInfo->IsSettable(*ParamId))
+            {
+                InitialParamIds.Add(*ParamId);
+                InitialParamValues.Add(Kvp.Value);
+                InitialParamNames.Add(Kvp.Key);
+            }
+            else
             {
                 UE_LOG(LogFMOD, Warning, TEXT("Failed to set initial parameter %s"), *Kvp.Key.ToString());
             }
         }
+        if (InitialParamIds.Num() > 0)
+        {
+            FMOD_RESULT Result = StudioInstance->setParametersByIDs(InitialParamIds.GetData(), InitialParamValues.GetData(), InitialParamIds.Num());
+            if (Result != FMOD_OK)
+            {
+                // Set them one at a time so the rest still apply, and so the failing ones can be named
+                for (int32 i = 0; i < InitialParamIds.Num(); ++i)
+                {
+                    Result = StudioInstance->setParameterByID(InitialParamIds[i], InitialParamValues[i]);
+                    if (Result != FMOD_OK)
+                    {
+                        UE_LOG(LogFMOD, Warning, TEXT("Failed to set initial parameter %s (%s)"), *InitialParamNames[i].ToString(),
+                            UTF8_TO_TCHAR(FMOD_ErrorString(Result)));
+                    }
+                }
+            }
+        }
         for (int i = 0; i < EFMODEventProperty::Count; ++i)
         {
             if (StoredProperties[i] != -1.0f)
@@ -672,27 +732,114 @@ void UFMODAudioComponent::PlayInternal(EFMODSystemContext::Type Context)
             }
         }
 
+        if (bEnableTimelineCallbacks && !TimelineCallbackQueue.IsValid())
+        {
+            // Created before the callback is set, and kept for the component's lifetime, so the FMOD thread never sees it change
+            TimelineCallbackQueue = MakeUnique<TCircularQueue<FTimelineCallbackProperties>>(TimelineCallbackQueueSize);
+        }
+
+        FMOD_STUDIO_EVENT_CALLBACK_TYPE CallbackMask = FMOD_STUDIO_EVENT_CALLBACK_STOPPED;
         if (bEnableTimelineCallbacks || !ProgrammerSoundName.IsEmpty())
         {
-            verifyfmod(StudioInstance->setCallback(UFMODAudioComponent_EventCallback));
+            CallbackMask = FMOD_STUDIO_EVENT_CALLBACK_ALL;
         }
+        verifyfmod(StudioInstance->setCallback(UFMODAudioComponent_EventCallback, CallbackMask));
         verifyfmod(StudioInstance->setUserData(this));
-        verifyfmod(StudioInstance->start());
+        FFMODPlaybackCompletionQueue::Get().Track(this, StudioInstance);
+        verifyfmod(FFMODCommandBuffer::Get().Start(StudioInstance));
         UE_LOG(LogFMOD, Verbose, TEXT("Playing component %p"), this);
         SetActiveFlag(true);
-        SetComponentTickEnabled(true);
+
+        // Only tick for work that depends on the listener or on queued timeline callbacks
+        SetComponentTickEnabled(bEnableTimelineCallbacks || bApplyAmbientVolumes);
+
+        // Only looping 3D events can be dropped and picked up again without being noticed
+        if (Settings.bVirtualizeInaudibleComponents && bAllowVirtualization && EventInfo->bIs3D && !EventInfo->bOneshot && GetWorld() &&
+            GetWorld()->IsGameWorld())
+        {
+            FFMODSignificanceManager::Get().Register(this);
+        }
     }
 }
 
 void UFMODAudioComponent::Stop()
 {
     UE_LOG(LogFMOD, Verbose, TEXT("UFMODAudioComponent %p Stop"), this);
+    bPlayQueued = false;
     if (StudioInstance)
     {
-        StudioInstance->stop(FMOD_STUDIO_STOP_ALLOWFADEOUT);
+        FFMODCommandBuffer::Get().Stop(StudioInstance, FMOD_STUDIO_STOP_ALLOWFADEOUT);
     }
 
-    wasOccluded = false;
+    if (bVirtual)
+    {
+        // There is no instance to stop, so let the next tick complete playback
+        bVirtual = false;
+        SetComponentTickEnabled(true);
+    }
+
+    OcclusionTarget = 0.0f;
+    OcclusionCurrent = -1.0f;
+}
+
+float UFMODAudioComponent::GetVirtualizationDistance() const
+{
+    if (AttenuationDetails.bOverrideAttenuation)
+    {
+        return AttenuationDetails.MaximumDistance;
+    }
+    if (StoredProperties[EFMODEventProperty::MaximumDistance] >= 0.0f)
+    {
+        return StoredProperties[EFMODEventProperty::MaximumDistance];
+    }
+    return EventMaximumDistance;
+}
+
+void UFMODAudioComponent::Virtualize()
+{
+    UE_LOG(LogFMOD, Verbose, TEXT("UFMODAudioComponent %p Virtualize"), this);
+
+    int Position = 0;
+    StudioInstance->getTimelinePosition(&Position);
+    VirtualTimelinePosition = Position;
+    VirtualStartTime = GetWorld() ? GetWorld()->GetAudioTimeSeconds() : 0.0f;
+
+    // Recorded, so a start made earlier this frame is replayed before it
+    FFMODCommandBuffer::Get().Stop(StudioInstance, FMOD_STUDIO_STOP_IMMEDIATE);
+    ReleaseEventInstance();
+
+    // Stay active so that the component still reports itself as playing
+    bVirtual = true;
+    OcclusionTarget = 0.0f;
+    OcclusionCurrent = -1.0f;
+    SetComponentTickEnabled(false);
+}
+
+void UFMODAudioComponent::Devirtualize()
+{
+    UE_LOG(LogFMOD, Verbose, TEXT("UFMODAudioComponent %p Devirtualize"), this);
+
+    bVirtual = false;
+
+    // Assume the timeline kept running, wrapping around for events that loop over their whole length
+    const float Elapsed = GetWorld() ? GetWorld()->GetAudioTimeSeconds() - VirtualStartTime : 0.0f;
+    int32 Position = VirtualTimelinePosition + FMath::Max(FMath::RoundToInt(Elapsed * 1000.0f), 0);
+
+    PlayInternal(EFMODSystemContext::Max);
+
+    if (StudioInstance)
+    {
+        if (EventLength > 0)
+        {
+            Position %= EventLength;
+        }
+        StudioInstance->setTimelinePosition(Position);
+    }
+    else
+    {
+        // The event could not be restarted, so finish as though it stopped
+        SetComponentTickEnabled(true);
+    }
 }
 
 void UFMODAudioComponent::Release()
@@ -722,9 +869,17 @@ void UFMODAudioComponent::ReleaseEventInstance()
             StudioInstance->setCallback(nullptr);
         }
 
-        StudioInstance->release();
+        FFMODPlaybackCompletionQueue::Get().Untrack(StudioInstance);
+        FFMODCommandBuffer::Get().Release(StudioInstance);
         StudioInstance = nullptr;
     }
+    EventInfo.Reset();
+
+    // Anything still queued refers to the released instance
+    if (TimelineCallbackQueue.IsValid())
+    {
+        TimelineCallbackQueue->Empty();
+    }
 }
 
 void UFMODAudioComponent::TriggerCue()
@@ -764,7 +919,7 @@ void UFMODAudioComponent::SetVolume(float Volume)
 {
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->setVolume(Volume);
+        FMOD_RESULT Result = FFMODCommandBuffer::Get().SetVolume(StudioInstance, Volume);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to set volume"));
@@ -776,7 +931,7 @@ void UFMODAudioComponent::SetPitch(float Pitch)
 {
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->setPitch(Pitch);
+        FMOD_RESULT Result = FFMODCommandBuffer::Get().SetPitch(StudioInstance, Pitch);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to set pitch"));
@@ -788,7 +943,7 @@ void UFMODAudioComponent::SetPaused(bool Paused)
 {
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->setPaused(Paused);
+        FMOD_RESULT Result = FFMODCommandBuffer::Get().SetPaused(StudioInstance, Paused);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to pause"));
@@ -800,7 +955,9 @@ void UFMODAudioComponent::SetParameter(FName Name, float Value)
 {
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->setParameterByName(TCHAR_TO_UTF8(*Name.ToString()), Value);
+        const FMOD_STUDIO_PARAMETER_ID *ParamId = EventInfo.IsValid() ? EventInfo->FindParameterId(Name) : nullptr;
+        FMOD_RESULT Result = ParamId ? FFMODCommandBuffer::Get().SetParameterByID(StudioInstance, *ParamId, Value) :
+                                       FFMODCommandBuffer::Get().SetParameterByName(StudioInstance, Name, Value);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to set parameter %s"), *Name.ToString());
@@ -827,15 +984,16 @@ float UFMODAudioComponent::GetProperty(EFMODEventProperty::Type Property)
 {
     verify(Property < EFMODEventProperty::Count);
     float outValue = 0;
-    if (Event)
+    if (StudioInstance)
     {
         FMOD_RESULT Result = StudioInstance->getProperty((FMOD_STUDIO_EVENT_PROPERTY)Property, &outValue);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to get property %d"), (int)Property);
         }
+        StoredProperties[Property] = outValue;
     }
-    return StoredProperties[Property] = outValue;
+    return StoredProperties[Property];
 }
 
 int32 UFMODAudioComponent::GetLength() const
@@ -880,7 +1038,9 @@ float UFMODAudioComponent::GetParameter(FName Name)
     float Value = CachedValue ? *CachedValue : 0.0;
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &Value);
+        const FMOD_STUDIO_PARAMETER_ID *ParamId = EventInfo.IsValid() ? EventInfo->FindParameterId(Name) : nullptr;
+        FMOD_RESULT Result = ParamId ? StudioInstance->getParameterByID(*ParamId, &Value) :
+                                       StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &Value);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to get parameter %s"), *Name.ToString());
@@ -899,7 +1059,9 @@ void UFMODAudioComponent::GetParameterValue(FName Name, float &UserValue, float
     float *CachedValue = ParameterCache.Find(Name);
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &UserValue, &FinalValue);
+        const FMOD_STUDIO_PARAMETER_ID *ParamId = EventInfo.IsValid() ? EventInfo->FindParameterId(Name) : nullptr;
+        FMOD_RESULT Result = ParamId ? StudioInstance->getParameterByID(*ParamId, &UserValue, &FinalValue) :
+                                       StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &UserValue, &FinalValue);
         if (Result != FMOD_OK)
         {
             UserValue = FinalValue = 0;
@@ -0,0 +1,216 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODBankLoader.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/ScopeLock.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+namespace
+{
+// The contents of one bank file, shared by every Studio system that loads it and kept alive while FMOD points into it
+struct FFMODBankBuffer
+{
+    FFMODBankBuffer(const FString &InPath, const FDateTime &InTimeStamp)
+        : Path(InPath)
+        , TimeStamp(InTimeStamp)
+        , Handle(nullptr)
+        , Region(nullptr)
+        , Memory(nullptr)
+        , Size(0)
+        , RefCount(0)
+    {
+    }
+
+    ~FFMODBankBuffer()
+    {
+        delete Region;
+        delete Handle;
+        FMemory::Free(Memory);
+    }
+
+    const char *GetData() const { return Region ? (const char *)Region->GetMappedPtr() : (const char *)Memory; }
+    bool IsMapped() const { return Region != nullptr; }
+
+    FString Path;
+    FDateTime TimeStamp;
+    IMappedFileHandle *Handle;
+    IMappedFileRegion *Region;
+    void *Memory;
+    int64 Size;
+    int32 RefCount;
+};
+
+bool MapBankFile(FFMODBankBuffer &Buffer)
+{
+    IMappedFileHandle *Handle = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Buffer.Path);
+    if (!Handle)
+    {
+        return false;
+    }
+
+    // loadBankMemory takes an int length
+    if (Handle->GetFileSize() <= 0 || Handle->GetFileSize() > MAX_int32)
+    {
+        delete Handle;
+        return false;
+    }
+
+    IMappedFileRegion *Region = Handle->MapRegion();
+    if (!Region)
+    {
+        delete Handle;
+        return false;
+    }
+
+    if (!IsAligned(Region->GetMappedPtr(), FMOD_STUDIO_LOAD_MEMORY_ALIGNMENT))
+    {
+        delete Region;
+        delete Handle;
+        return false;
+    }
+
+    Buffer.Handle = Handle;
+    Buffer.Region = Region;
+    Buffer.Size = Region->GetMappedSize();
+    return true;
+}
+
+bool ReadBankFile(FFMODBankBuffer &Buffer)
+{
+    TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Buffer.Path));
+    if (!File.IsValid() || File->Size() <= 0 || File->Size() > MAX_int32)
+    {
+        return false;
+    }
+
+    Buffer.Size = File->Size();
+    Buffer.Memory = FMemory::Malloc(Buffer.Size, FMOD_STUDIO_LOAD_MEMORY_ALIGNMENT);
+    return File->Read((uint8 *)Buffer.Memory, Buffer.Size);
+}
+
+FCriticalSection BuffersCrit;
+
+// The current buffer for each file, so later loads of an unchanged file share it
+TMap<FString, FFMODBankBuffer *> SharedBuffers;
+
+// The buffer each loaded bank points into
+TMap<FMOD::Studio::Bank *, FFMODBankBuffer *> BankBuffers;
+
+// Editor banks loaded straight from their files, so a second system loading the same file knows to share it
+TMap<FMOD::Studio::Bank *, FString> FileBanks;
+
+// Must be called with BuffersCrit held
+void ReleaseBuffer(FFMODBankBuffer *Buffer)
+{
+    if (--Buffer->RefCount == 0)
+    {
+        FFMODBankBuffer **Shared = SharedBuffers.Find(Buffer->Path);
+        if (Shared && *Shared == Buffer)
+        {
+            SharedBuffers.Remove(Buffer->Path);
+        }
+        delete Buffer;
+    }
+}
+
+FFMODBankBuffer *AcquireBuffer(const FString &Path, bool bMemoryMap)
+{
+    const FDateTime TimeStamp = IFileManager::Get().GetTimeStamp(*Path);
+
+    {
+        FScopeLock Lock(&BuffersCrit);
+        FFMODBankBuffer **Shared = SharedBuffers.Find(Path);
+        if (Shared && (*Shared)->TimeStamp == TimeStamp && (*Shared)->IsMapped() == bMemoryMap)
+        {
+            (*Shared)->RefCount++;
+            return *Shared;
+        }
+    }
+
+    // Read outside the lock, other systems can keep loading banks meanwhile
+    FFMODBankBuffer *Buffer = new FFMODBankBuffer(Path, TimeStamp);
+    if (!(bMemoryMap ? MapBankFile(*Buffer) : ReadBankFile(*Buffer)))
+    {
+        delete Buffer;
+        return nullptr;
+    }
+
+    FScopeLock Lock(&BuffersCrit);
+    FFMODBankBuffer *&Shared = SharedBuffers.FindOrAdd(Path);
+    if (Shared && Shared->TimeStamp == TimeStamp && Shared->IsMapped() == bMemoryMap)
+    {
+        // Another thread loaded the same file first
+        delete Buffer;
+        Shared->RefCount++;
+        return Shared;
+    }
+
+    // Any older version stays alive until the banks using it are unloaded
+    Shared = Buffer;
+    Buffer->RefCount = 1;
+    return Buffer;
+}
+}
+
+FMOD_RESULT FMODLoadBankFile(
+    FMOD::Studio::System *StudioSystem, const FString &Path, FMOD_STUDIO_LOAD_BANK_FLAGS Flags, FMOD::Studio::Bank **OutBank, bool bMemoryMap)
+{
+    // The editor's auditioning, editor and runtime systems can all load the same banks.  A whole file in memory costs
+    // more than a bank loaded normally, so a shared copy is only read once a second system loads the file.  Copies are
+    // read rather than mapped there, so that Studio can still overwrite the files when rebuilding.
+    bool bShare = bMemoryMap;
+    if (!bShare && GIsEditor)
+    {
+        FScopeLock Lock(&BuffersCrit);
+        bShare = SharedBuffers.Contains(Path) || FileBanks.FindKey(Path) != nullptr;
+    }
+    FFMODBankBuffer *Buffer = bShare ? AcquireBuffer(Path, bMemoryMap) : nullptr;
+
+    if (!Buffer)
+    {
+        if (bShare)
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT("Could not share bank %s, loading from file instead"), *Path);
+        }
+
+        FMOD_RESULT Result = StudioSystem->loadBankFile(TCHAR_TO_UTF8(*Path), Flags, OutBank);
+        if (GIsEditor && Result == FMOD_OK && *OutBank)
+        {
+            FScopeLock Lock(&BuffersCrit);
+            FileBanks.Add(*OutBank, Path);
+        }
+        return Result;
+    }
+
+    FMOD::Studio::Bank *Bank = nullptr;
+    FMOD_RESULT Result = StudioSystem->loadBankMemory(Buffer->GetData(), (int)Buffer->Size, FMOD_STUDIO_LOAD_MEMORY_POINT, Flags, &Bank);
+
+    FScopeLock Lock(&BuffersCrit);
+    if (Result == FMOD_OK && Bank)
+    {
+        // Released from the bank unload callback once FMOD no longer references the memory
+        BankBuffers.Add(Bank, Buffer);
+    }
+    else
+    {
+        ReleaseBuffer(Buffer);
+    }
+
+    *OutBank = Bank;
+    return Result;
+}
+
+void FMODReleaseBankMemory(FMOD::Studio::Bank *Bank)
+{
+    FScopeLock Lock(&BuffersCrit);
+    FileBanks.Remove(Bank);
+
+    FFMODBankBuffer *Buffer = nullptr;
+    if (BankBuffers.RemoveAndCopyValue(Bank, Buffer))
+    {
+        ReleaseBuffer(Buffer);
+    }
+}
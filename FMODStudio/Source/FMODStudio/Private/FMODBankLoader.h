@@ -0,0 +1,19 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "fmod_studio.hpp"
+#include "Containers/UnrealString.h"
+
+/**
+ * Load a bank file into a Studio system.
+ * When bMemoryMap is set, or in the editor once a second system loads the same file, the file is mapped or read into
+ * memory once and handed to every system that loads it with FMOD_STUDIO_LOAD_MEMORY_POINT, falling back to loadBankFile
+ * if that fails.  The memory is reference counted per bank and a file that has changed on disk since it was read gets a
+ * fresh copy.
+ */
+FMOD_RESULT FMODLoadBankFile(
+    FMOD::Studio::System *StudioSystem, const FString &Path, FMOD_STUDIO_LOAD_BANK_FLAGS Flags, FMOD::Studio::Bank **OutBank, bool bMemoryMap);
+
+/** Release any memory backing the bank.  Must only be called once FMOD has finished unloading it. */
+void FMODReleaseBankMemory(FMOD::Studio::Bank *Bank);
@@ -0,0 +1,260 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODBankManager.h"
+#include "FMODBank.h"
+#include "FMODBankLoader.h"
+#include "FMODSettings.h"
+#include "FMODStudioModule.h"
+#include "FMODUtils.h"
+#include "HAL/FileManager.h"
+#include "fmod_studio.hpp"
+#include "fmod_errors.h"
+#include "FMODStudioPrivatePCH.h"
+
+FFMODBankManager::FFMODBankManager()
+    : LoadedBytes(0)
+    , UseCounter(0)
+{
+}
+
+FFMODBankManager &FFMODBankManager::Get()
+{
+    static FFMODBankManager Instance;
+    return Instance;
+}
+
+bool FFMODBankManager::Acquire(FMOD::Studio::System *StudioSystem, const UFMODBank *Bank, bool bSampleData)
+{
+    check(IsInGameThread());
+
+    if (!StudioSystem || !IsValid(Bank))
+    {
+        return false;
+    }
+
+    FEntry *Entry = Entries.Find(Bank->AssetGuid);
+
+    if (Entry && Entry->Bank && !Entry->Bank->isValid())
+    {
+        // The bank was unloaded behind our back, for example by a live reload
+        LoadedBytes -= Entry->bOwnsSampleData ? Entry->SampleDataBytes : 0;
+        Entry->bSampleDataLoaded = false;
+        Entry->bOwnsSampleData = false;
+        Entry->Bank = nullptr;
+    }
+
+    if (!Entry || !Entry->Bank)
+    {
+        FMOD::Studio::Bank *StudioBank = nullptr;
+        bool bOwnsBank = false;
+
+        FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Bank->AssetGuid);
+        if (StudioSystem->getBankByID(&Guid, &StudioBank) != FMOD_OK || !StudioBank)
+        {
+            FString BankPath = IFMODStudioModule::Get().GetBankPath(*Bank);
+            FMOD_RESULT Result = FMODLoadBankFile(
+                StudioSystem, BankPath, FMOD_STUDIO_LOAD_BANK_NONBLOCKING, &StudioBank, GetDefault<UFMODSettings>()->bMemoryMapBanks);
+
+            if (Result != FMOD_OK)
+            {
+                UE_LOG(LogFMOD, Error, TEXT("Failed to load bank %s: %s"), *Bank->FileName, UTF8_TO_TCHAR(FMOD_ErrorString(Result)));
+                return false;
+            }
+
+            bOwnsBank = true;
+        }
+
+        if (!Entry)
+        {
+            Entry = &Entries.Add(Bank->AssetGuid);
+            Entry->BankRefs = 0;
+            Entry->SampleDataRefs = 0;
+            Entry->bSampleDataLoaded = false;
+            Entry->bOwnsSampleData = false;
+        }
+
+        Entry->Bank = StudioBank;
+        Entry->Path = IFMODStudioModule::Get().GetBankPath(*Bank);
+        Entry->bOwnsBank = bOwnsBank;
+
+        // Studio doesn't report per-bank memory, but sample data makes up nearly all of a bank file
+        Entry->SampleDataBytes = FMath::Max<int64>(IFileManager::Get().FileSize(*Entry->Path), 0);
+    }
+
+    Entry->BankRefs++;
+    Entry->LastUsed = ++UseCounter;
+
+    if (bSampleData)
+    {
+        Entry->SampleDataRefs++;
+
+        if (!Entry->bSampleDataLoaded)
+        {
+            // Sample data loaded by someone else, such as LoadBanks with Load All Sample Data, is theirs to unload
+            FMOD_STUDIO_LOADING_STATE State = FMOD_STUDIO_LOADING_STATE_UNLOADED;
+            Entry->Bank->getSampleLoadingState(&State);
+            Entry->bSampleDataLoaded = true;
+            Entry->bOwnsSampleData = State == FMOD_STUDIO_LOADING_STATE_UNLOADED || State == FMOD_STUDIO_LOADING_STATE_UNLOADING;
+
+            if (Entry->bOwnsSampleData)
+            {
+                UE_LOG(LogFMOD, Verbose, TEXT("Loading sample data for bank %s"), *Bank->FileName);
+                verifyfmod(Entry->Bank->loadSampleData());
+                LoadedBytes += Entry->SampleDataBytes;
+                Trim();
+            }
+        }
+    }
+
+    return true;
+}
+
+void FFMODBankManager::Release(const UFMODBank *Bank, bool bSampleData)
+{
+    check(IsInGameThread());
+
+    if (!IsValid(Bank))
+    {
+        return;
+    }
+
+    FEntry *Entry = Entries.Find(Bank->AssetGuid);
+    if (!Entry || Entry->BankRefs == 0 || (bSampleData && Entry->SampleDataRefs == 0))
+    {
+        UE_LOG(LogFMOD, Warning, TEXT("Released bank %s more times than it was acquired"), *Bank->FileName);
+        return;
+    }
+
+    Entry->BankRefs--;
+    Entry->LastUsed = ++UseCounter;
+
+    if (bSampleData)
+    {
+        Entry->SampleDataRefs--;
+
+        if (Entry->SampleDataRefs == 0 && !Entry->bOwnsSampleData)
+        {
+            // Nothing to evict, the sample data stays with whoever loaded it
+            Entry->bSampleDataLoaded = false;
+        }
+    }
+
+    Trim();
+    RemoveIfUnused(Bank->AssetGuid);
+}
+
+void FFMODBankManager::GetStats(int64 &OutLoadedBytes, int64 &OutCachedBytes, int32 &OutNumBanks) const
+{
+    OutLoadedBytes = LoadedBytes;
+    OutCachedBytes = 0;
+    OutNumBanks = Entries.Num();
+
+    for (const TPair<FGuid, FEntry> &Pair : Entries)
+    {
+        if (Pair.Value.bOwnsSampleData && Pair.Value.SampleDataRefs == 0)
+        {
+            OutCachedBytes += Pair.Value.SampleDataBytes;
+        }
+    }
+}
+
+void FFMODBankManager::Reset(bool bReleaseLoaded)
+{
+    if (bReleaseLoaded)
+    {
+        for (TPair<FGuid, FEntry> &Pair : Entries)
+        {
+            FEntry &Entry = Pair.Value;
+            if (!Entry.Bank || !Entry.Bank->isValid())
+            {
+                continue;
+            }
+
+            // Unloading a bank takes its sample data with it
+            if (Entry.bOwnsBank)
+            {
+                verifyfmod(Entry.Bank->unload());
+            }
+            else if (Entry.bOwnsSampleData)
+            {
+                verifyfmod(Entry.Bank->unloadSampleData());
+            }
+        }
+    }
+
+    Entries.Reset();
+    LoadedBytes = 0;
+}
+
+void FFMODBankManager::Trim()
+{
+    const int64 Budget = GetSampleDataBudget();
+
+    while (LoadedBytes > Budget)
+    {
+        FGuid OldestGuid;
+        FEntry *Oldest = nullptr;
+
+        for (TPair<FGuid, FEntry> &Pair : Entries)
+        {
+            FEntry &Entry = Pair.Value;
+            if (Entry.bOwnsSampleData && Entry.SampleDataRefs == 0 && (!Oldest || Entry.LastUsed < Oldest->LastUsed))
+            {
+                OldestGuid = Pair.Key;
+                Oldest = &Entry;
+            }
+        }
+
+        if (!Oldest)
+        {
+            // Everything left is in use
+            break;
+        }
+
+        UE_LOG(LogFMOD, Verbose, TEXT("Evicting sample data for bank %s"), *Oldest->Path);
+
+        if (Oldest->Bank && Oldest->Bank->isValid())
+        {
+            verifyfmod(Oldest->Bank->unloadSampleData());
+        }
+        Oldest->bSampleDataLoaded = false;
+        Oldest->bOwnsSampleData = false;
+        LoadedBytes -= Oldest->SampleDataBytes;
+
+        RemoveIfUnused(OldestGuid);
+    }
+}
+
+void FFMODBankManager::RemoveIfUnused(const FGuid &Guid)
+{
+    FEntry *Entry = Entries.Find(Guid);
+
+    if (Entry && Entry->BankRefs == 0 && !Entry->bSampleDataLoaded)
+    {
+        if (Entry->bOwnsBank && Entry->Bank && Entry->Bank->isValid())
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT("Unloading bank %s"), *Entry->Path);
+            verifyfmod(Entry->Bank->unload());
+        }
+
+        Entries.Remove(Guid);
+    }
+}
+
+int64 FFMODBankManager::GetSampleDataBudget()
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+
+#if PLATFORM_IOS || PLATFORM_TVOS || PLATFORM_ANDROID
+    int64 Megabytes = Settings.SampleDataBudget.Mobile;
+#elif PLATFORM_PS4
+    int64 Megabytes = Settings.SampleDataBudget.PS4;
+#elif PLATFORM_XBOXONE
+    int64 Megabytes = Settings.SampleDataBudget.XboxOne;
+#elif PLATFORM_SWITCH
+    int64 Megabytes = Settings.SampleDataBudget.Switch;
+#else
+    int64 Megabytes = Settings.SampleDataBudget.Desktop;
+#endif
+    return Megabytes * 1024 * 1024;
+}
@@ -0,0 +1,71 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace FMOD
+{
+namespace Studio
+{
+class System;
+class Bank;
+}
+}
+
+class UFMODBank;
+
+/**
+ * Reference counts banks and their sample data on the runtime system.  Banks are loaded on first use, and sample data
+ * that is no longer referenced stays loaded until the sample data budget is exceeded, least recently used first.
+ * Banks and sample data that were already loaded, such as at startup, are shared but never unloaded by the manager.
+ * Game thread only.
+ */
+class FFMODBankManager
+{
+public:
+    FFMODBankManager();
+
+    static FFMODBankManager &Get();
+
+    /** Add a reference to a bank, and to its sample data if requested, loading them if needed.  Returns false if the bank could not be loaded. */
+    bool Acquire(FMOD::Studio::System *StudioSystem, const UFMODBank *Bank, bool bSampleData);
+
+    /** Drop a reference added by Acquire, passing the same sample data flag */
+    void Release(const UFMODBank *Bank, bool bSampleData);
+
+    /** Bytes of sample data loaded through the manager, and how much of that is unreferenced and may be evicted */
+    void GetStats(int64 &OutLoadedBytes, int64 &OutCachedBytes, int32 &OutNumBanks) const;
+
+    /**
+     * Forget every bank, called when the runtime system is about to be released along with its banks.
+     * Pass bReleaseLoaded when the system is kept instead, so that banks and sample data the manager loaded are unloaded first.
+     */
+    void Reset(bool bReleaseLoaded);
+
+private:
+    struct FEntry
+    {
+        FMOD::Studio::Bank *Bank;
+        FString Path;
+        int32 BankRefs;
+        int32 SampleDataRefs;
+        bool bOwnsBank;
+        bool bSampleDataLoaded;
+        bool bOwnsSampleData;
+        int64 SampleDataBytes;
+        uint64 LastUsed;
+    };
+
+    /** Unload unreferenced sample data until the loaded total fits the platform budget */
+    void Trim();
+
+    /** Unload the bank of an entry nothing references any more, and forget it */
+    void RemoveIfUnused(const FGuid &Guid);
+
+    static int64 GetSampleDataBudget();
+
+    TMap<FGuid, FEntry> Entries;
+    int64 LoadedBytes;
+    uint64 UseCounter;
+};
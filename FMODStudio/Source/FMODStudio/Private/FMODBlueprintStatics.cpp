@@ -9,6 +9,12 @@
 #include "FMODEvent.h"
 #include "FMODBus.h"
 #include "FMODVCA.h"
+#include "FMODBankLoader.h"
+#include "FMODBankManager.h"
+#include "FMODCommandBuffer.h"
+#include "FMODEventDescriptionCache.h"
+#include "FMODInstancePool.h"
+#include "FMODProgrammerSoundCache.h"
 #include "fmod_studio.hpp"
 #include "fmod_errors.h"
 #include "FMODStudioPrivatePCH.h"
@@ -32,24 +38,55 @@ FFMODEventInstance UFMODBlueprintStatics::PlayEventAtLocation(
     FFMODEventInstance Instance;
     Instance.Instance = nullptr;
 
+    if (bAutoPlay && !IFMODStudioModule::Get().IsSystemReady())
+    {
+        // Nothing can be handed back yet, so fire and forget the event once the system is up
+        TWeakObjectPtr<UObject> WeakContext = WorldContextObject;
+        TWeakObjectPtr<UFMODEvent> WeakEvent = Event;
+        IFMODStudioModule::Get().QueueUntilReady([WeakContext, WeakEvent, Location]() {
+            if (WeakContext.IsValid() && WeakEvent.IsValid())
+            {
+                PlayEventAtLocation(WeakContext.Get(), WeakEvent.Get(), Location, true);
+            }
+        });
+        return Instance;
+    }
+
     UWorld *ThisWorld = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
     if (FMODUtils::IsWorldAudible(ThisWorld, false) && IsValid(Event))
     {
         FMOD::Studio::EventDescription *EventDesc = IFMODStudioModule::Get().GetEventDescription(Event);
         if (EventDesc != nullptr)
         {
+            // Only fire and forget instances on the runtime system are pooled, anything else is owned by the caller
+            const bool bPooled = bAutoPlay && Event->bPoolInstances &&
+                                 IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime) != nullptr;
+
             FMOD::Studio::EventInstance *EventInst = nullptr;
-            EventDesc->createInstance(&EventInst);
+            if (bPooled)
+            {
+                EventInst = FFMODInstancePool::Get().Acquire(EventDesc);
+            }
+            else
+            {
+                EventDesc->createInstance(&EventInst);
+            }
             if (EventInst != nullptr)
             {
                 FMOD_3D_ATTRIBUTES EventAttr = { { 0 } };
                 FMODUtils::Assign(EventAttr, Location);
-                EventInst->set3DAttributes(&EventAttr);
+                FFMODCommandBuffer::Get().Set3DAttributes(EventInst, EventAttr);
 
-                if (bAutoPlay)
+                if (bPooled)
+                {
+                    // The pool owns the instance and hands it to other plays once it stops, so it isn't returned
+                    FFMODInstancePool::Get().Play(EventDesc, EventInst);
+                    return Instance;
+                }
+                else if (bAutoPlay)
                 {
-                    EventInst->start();
-                    EventInst->release();
+                    FFMODCommandBuffer::Get().Start(EventInst);
+                    FFMODCommandBuffer::Get().Release(EventInst);
                 }
                 Instance.Instance = EventInst;
             }
@@ -137,7 +174,7 @@ void UFMODBlueprintStatics::LoadBank(class UFMODBank *Bank, bool bBlocking, bool
         FString BankPath = IFMODStudioModule::Get().GetBankPath(*Bank);
         FMOD::Studio::Bank *bank = nullptr;
         FMOD_STUDIO_LOAD_BANK_FLAGS flags = (bBlocking || bLoadSampleData) ? FMOD_STUDIO_LOAD_BANK_NORMAL : FMOD_STUDIO_LOAD_BANK_NONBLOCKING;
-        FMOD_RESULT result = StudioSystem->loadBankFile(TCHAR_TO_UTF8(*BankPath), flags, &bank);
+        FMOD_RESULT result = FMODLoadBankFile(StudioSystem, BankPath, flags, &bank, GetDefault<UFMODSettings>()->bMemoryMapBanks);
 
         if (result != FMOD_OK)
         {
@@ -218,6 +255,20 @@ void UFMODBlueprintStatics::UnloadBankSampleData(class UFMODBank *Bank)
     }
 }
 
+bool UFMODBlueprintStatics::AcquireBank(class UFMODBank *Bank, bool bSampleData)
+{
+    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
+    return FFMODBankManager::Get().Acquire(StudioSystem, Bank, bSampleData);
+}
+
+void UFMODBlueprintStatics::ReleaseBank(class UFMODBank *Bank, bool bSampleData)
+{
+    if (IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime) != nullptr)
+    {
+        FFMODBankManager::Get().Release(Bank, bSampleData);
+    }
+}
+
 void UFMODBlueprintStatics::LoadEventSampleData(UObject *WorldContextObject, class UFMODEvent *Event)
 {
     if (IsValid(Event))
@@ -242,6 +293,44 @@ void UFMODBlueprintStatics::UnloadEventSampleData(UObject *WorldContextObject, c
     }
 }
 
+void UFMODBlueprintStatics::EnableEventPooling(class UFMODEvent *Event, int32 PrewarmSize)
+{
+    if (IsValid(Event))
+    {
+        Event->bPoolInstances = true;
+        Event->PoolPrewarmSize = FMath::Max(PrewarmSize, 0);
+
+        FMOD::Studio::EventDescription *EventDesc = IFMODStudioModule::Get().GetEventDescription(Event, EFMODSystemContext::Runtime);
+        if (EventDesc != nullptr)
+        {
+            FFMODInstancePool::Get().Prewarm(EventDesc, Event->PoolPrewarmSize);
+        }
+    }
+}
+
+void UFMODBlueprintStatics::DisableEventPooling(class UFMODEvent *Event)
+{
+    if (IsValid(Event))
+    {
+        Event->bPoolInstances = false;
+
+        FMOD::Studio::EventDescription *EventDesc = IFMODStudioModule::Get().GetEventDescription(Event, EFMODSystemContext::Runtime);
+        if (EventDesc != nullptr)
+        {
+            FFMODInstancePool::Get().Drain(EventDesc);
+        }
+    }
+}
+
+void UFMODBlueprintStatics::PrefetchProgrammerSounds(const TArray<FString> &SoundNames)
+{
+    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Max);
+    if (StudioSystem != nullptr)
+    {
+        FFMODProgrammerSoundCache::Get().Prefetch(StudioSystem, SoundNames);
+    }
+}
+
 TArray<FFMODEventInstance> UFMODBlueprintStatics::FindEventInstances(UObject *WorldContextObject, UFMODEvent *Event)
 {
     TArray<FFMODEventInstance> Instances;
@@ -271,76 +360,46 @@ TArray<FFMODEventInstance> UFMODBlueprintStatics::FindEventInstances(UObject *Wo
 
 void UFMODBlueprintStatics::BusSetVolume(class UFMODBus *Bus, float Volume)
 {
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
-    if (StudioSystem != nullptr && IsValid(Bus))
+    FMOD::Studio::Bus *bus = IFMODStudioModule::Get().GetBus(Bus);
+    if (bus != nullptr)
     {
-        FMOD::Studio::ID guid = FMODUtils::ConvertGuid(Bus->AssetGuid);
-        FMOD::Studio::Bus *bus = nullptr;
-        FMOD_RESULT result = StudioSystem->getBusByID(&guid, &bus);
-        if (result == FMOD_OK && bus != nullptr)
-        {
-            bus->setVolume(Volume);
-        }
+        bus->setVolume(Volume);
     }
 }
 
 void UFMODBlueprintStatics::BusSetPaused(class UFMODBus *Bus, bool bPaused)
 {
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
-    if (StudioSystem != nullptr && IsValid(Bus))
+    FMOD::Studio::Bus *bus = IFMODStudioModule::Get().GetBus(Bus);
+    if (bus != nullptr)
     {
-        FMOD::Studio::ID guid = FMODUtils::ConvertGuid(Bus->AssetGuid);
-        FMOD::Studio::Bus *bus = nullptr;
-        FMOD_RESULT result = StudioSystem->getBusByID(&guid, &bus);
-        if (result == FMOD_OK && bus != nullptr)
-        {
-            bus->setPaused(bPaused);
-        }
+        bus->setPaused(bPaused);
     }
 }
 
 void UFMODBlueprintStatics::BusSetMute(class UFMODBus *Bus, bool bMute)
 {
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
-    if (StudioSystem != nullptr && IsValid(Bus))
+    FMOD::Studio::Bus *bus = IFMODStudioModule::Get().GetBus(Bus);
+    if (bus != nullptr)
     {
-        FMOD::Studio::ID guid = FMODUtils::ConvertGuid(Bus->AssetGuid);
-        FMOD::Studio::Bus *bus = nullptr;
-        FMOD_RESULT result = StudioSystem->getBusByID(&guid, &bus);
-        if (result == FMOD_OK && bus != nullptr)
-        {
-            bus->setMute(bMute);
-        }
+        bus->setMute(bMute);
     }
 }
 
 void UFMODBlueprintStatics::BusStopAllEvents(UFMODBus *Bus, EFMOD_STUDIO_STOP_MODE stopMode)
 {
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
-    if (StudioSystem != nullptr && IsValid(Bus))
+    FMOD::Studio::Bus *bus = IFMODStudioModule::Get().GetBus(Bus);
+    if (bus != nullptr)
     {
-        FMOD::Studio::ID guid = FMODUtils::ConvertGuid(Bus->AssetGuid);
-        FMOD::Studio::Bus *bus = nullptr;
-        FMOD_RESULT result = StudioSystem->getBusByID(&guid, &bus);
-        if (result == FMOD_OK && bus != nullptr)
-        {
-            bus->stopAllEvents((FMOD_STUDIO_STOP_MODE)stopMode);
-        }
+        bus->stopAllEvents((FMOD_STUDIO_STOP_MODE)stopMode);
     }
 }
 
 void UFMODBlueprintStatics::VCASetVolume(class UFMODVCA *Vca, float Volume)
 {
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
-    if (StudioSystem != nullptr && IsValid(Vca))
+    FMOD::Studio::VCA *vca = IFMODStudioModule::Get().GetVCA(Vca);
+    if (vca != nullptr)
     {
-        FMOD::Studio::ID guid = FMODUtils::ConvertGuid(Vca->AssetGuid);
-        FMOD::Studio::VCA *vca = nullptr;
-        FMOD_RESULT result = StudioSystem->getVCAByID(&guid, &vca);
-        if (result == FMOD_OK && vca != nullptr)
-        {
-            vca->setVolume(Volume);
-        }
+        vca->setVolume(Volume);
     }
 }
 
@@ -399,7 +458,7 @@ void UFMODBlueprintStatics::EventInstanceSetVolume(FFMODEventInstance EventInsta
 {
     if (EventInstance.Instance)
     {
-        FMOD_RESULT Result = EventInstance.Instance->setVolume(Volume);
+        FMOD_RESULT Result = FFMODCommandBuffer::Get().SetVolume(EventInstance.Instance, Volume);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to set event instance volume"));
@@ -411,7 +470,7 @@ void UFMODBlueprintStatics::EventInstanceSetPitch(FFMODEventInstance EventInstan
 {
     if (EventInstance.Instance)
     {
-        FMOD_RESULT Result = EventInstance.Instance->setPitch(Pitch);
+        FMOD_RESULT Result = FFMODCommandBuffer::Get().SetPitch(EventInstance.Instance, Pitch);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to set event instance pitch"));
@@ -423,7 +482,7 @@ void UFMODBlueprintStatics::EventInstanceSetPaused(FFMODEventInstance EventInsta
 {
     if (EventInstance.Instance)
     {
-        FMOD_RESULT Result = EventInstance.Instance->setPaused(Paused);
+        FMOD_RESULT Result = FFMODCommandBuffer::Get().SetPaused(EventInstance.Instance, Paused);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to pause event instance"));
@@ -435,7 +494,10 @@ void UFMODBlueprintStatics::EventInstanceSetParameter(FFMODEventInstance EventIn
 {
     if (EventInstance.Instance)
     {
-        FMOD_RESULT Result = EventInstance.Instance->setParameterByName(TCHAR_TO_UTF8(*Name.ToString()), Value);
+        FMOD_STUDIO_PARAMETER_ID ParamId;
+        FMOD_RESULT Result = FFMODEventDescriptionCache::Get().FindParameterId(EventInstance.Instance, Name, ParamId) ?
+                                 FFMODCommandBuffer::Get().SetParameterByID(EventInstance.Instance, ParamId, Value) :
+                                 FFMODCommandBuffer::Get().SetParameterByName(EventInstance.Instance, Name, Value);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to set event instance parameter %s"), *Name.ToString());
@@ -448,7 +510,10 @@ float UFMODBlueprintStatics::EventInstanceGetParameter(FFMODEventInstance EventI
     float Value = 0.0f;
     if (EventInstance.Instance)
     {
-        FMOD_RESULT Result = EventInstance.Instance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &Value);
+        FMOD_STUDIO_PARAMETER_ID ParamId;
+        FMOD_RESULT Result = FFMODEventDescriptionCache::Get().FindParameterId(EventInstance.Instance, Name, ParamId) ?
+                                 EventInstance.Instance->getParameterByID(ParamId, &Value) :
+                                 EventInstance.Instance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &Value);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to get event instance parameter %s"), *Name.ToString());
@@ -461,7 +526,10 @@ void UFMODBlueprintStatics::EventInstanceGetParameterValue(FFMODEventInstance Ev
 {
     if (EventInstance.Instance)
     {
-        FMOD_RESULT Result = EventInstance.Instance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &UserValue, &FinalValue);
+        FMOD_STUDIO_PARAMETER_ID ParamId;
+        FMOD_RESULT Result = FFMODEventDescriptionCache::Get().FindParameterId(EventInstance.Instance, Name, ParamId) ?
+                                 EventInstance.Instance->getParameterByID(ParamId, &UserValue, &FinalValue) :
+                                 EventInstance.Instance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &UserValue, &FinalValue);
         if (Result != FMOD_OK)
         {
             UserValue = FinalValue = 0.0f;
@@ -488,13 +556,13 @@ void UFMODBlueprintStatics::EventInstancePlay(FFMODEventInstance EventInstance)
 {
     if (EventInstance.Instance)
     {
-        FMOD_RESULT Result = EventInstance.Instance->start();
+        FMOD_RESULT Result = FFMODCommandBuffer::Get().Start(EventInstance.Instance);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to play event instance"));
         }
         // Once we start playing, allow instance to be cleaned up when it finishes
-        EventInstance.Instance->release();
+        FFMODCommandBuffer::Get().Release(EventInstance.Instance);
     }
 }
 
@@ -502,7 +570,7 @@ void UFMODBlueprintStatics::EventInstanceStop(FFMODEventInstance EventInstance,
 {
     if (EventInstance.Instance)
     {
-        FMOD_RESULT Result = EventInstance.Instance->stop(FMOD_STUDIO_STOP_ALLOWFADEOUT);
+        FMOD_RESULT Result = FFMODCommandBuffer::Get().Stop(EventInstance.Instance, FMOD_STUDIO_STOP_ALLOWFADEOUT);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to stop event instance"));
@@ -522,7 +590,7 @@ void UFMODBlueprintStatics::EventInstanceRelease(FFMODEventInstance EventInstanc
 {
     if (EventInstance.Instance)
     {
-        FMOD_RESULT Result = EventInstance.Instance->release();
+        FMOD_RESULT Result = FFMODCommandBuffer::Get().Release(EventInstance.Instance);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to release event instance"));
@@ -544,7 +612,7 @@ void UFMODBlueprintStatics::EventInstanceSetTransform(FFMODEventInstance EventIn
     {
         FMOD_3D_ATTRIBUTES attr = { { 0 } };
         FMODUtils::Assign(attr, Location);
-        FMOD_RESULT Result = EventInstance.Instance->set3DAttributes(&attr);
+        FMOD_RESULT Result = FFMODCommandBuffer::Get().Set3DAttributes(EventInstance.Instance, attr);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to set transform on event instance"));
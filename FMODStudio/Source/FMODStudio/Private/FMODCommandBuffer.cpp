@@ -0,0 +1,220 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODCommandBuffer.h"
+#include "fmod_studio.hpp"
+#include "fmod_errors.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+FFMODCommandBuffer::FFMODCommandBuffer()
+    : bEnabled(false)
+{
+}
+
+FFMODCommandBuffer &FFMODCommandBuffer::Get()
+{
+    static FFMODCommandBuffer Instance;
+    return Instance;
+}
+
+void FFMODCommandBuffer::SetEnabled(bool bInEnabled)
+{
+    if (bEnabled && !bInEnabled)
+    {
+        Flush();
+    }
+    bEnabled = bInEnabled;
+}
+
+FMOD_RESULT FFMODCommandBuffer::SetParameterByID(FMOD::Studio::EventInstance *Instance, const FMOD_STUDIO_PARAMETER_ID &Id, float Value)
+{
+    if (!ShouldRecord())
+    {
+        return Instance->setParameterByID(Id, Value);
+    }
+    FindOrAdd(ECommand::SetParameterByID, Instance, &Id).Value = Value;
+    return FMOD_OK;
+}
+
+FMOD_RESULT FFMODCommandBuffer::SetParameterByName(FMOD::Studio::EventInstance *Instance, const FName &Name, float Value)
+{
+    if (!ShouldRecord())
+    {
+        return Instance->setParameterByName(TCHAR_TO_UTF8(*Name.ToString()), Value);
+    }
+    FindOrAdd(ECommand::SetParameterByName, Instance, nullptr, Name).Value = Value;
+    return FMOD_OK;
+}
+
+FMOD_RESULT FFMODCommandBuffer::Set3DAttributes(FMOD::Studio::EventInstance *Instance, const FMOD_3D_ATTRIBUTES &Attributes)
+{
+    if (!ShouldRecord())
+    {
+        return Instance->set3DAttributes(&Attributes);
+    }
+    FindOrAdd(ECommand::Set3DAttributes, Instance).Attributes = Attributes;
+    return FMOD_OK;
+}
+
+FMOD_RESULT FFMODCommandBuffer::SetVolume(FMOD::Studio::EventInstance *Instance, float Volume)
+{
+    if (!ShouldRecord())
+    {
+        return Instance->setVolume(Volume);
+    }
+    FindOrAdd(ECommand::SetVolume, Instance).Value = Volume;
+    return FMOD_OK;
+}
+
+FMOD_RESULT FFMODCommandBuffer::SetPitch(FMOD::Studio::EventInstance *Instance, float Pitch)
+{
+    if (!ShouldRecord())
+    {
+        return Instance->setPitch(Pitch);
+    }
+    FindOrAdd(ECommand::SetPitch, Instance).Value = Pitch;
+    return FMOD_OK;
+}
+
+FMOD_RESULT FFMODCommandBuffer::SetPaused(FMOD::Studio::EventInstance *Instance, bool bPaused)
+{
+    if (!ShouldRecord())
+    {
+        return Instance->setPaused(bPaused);
+    }
+    FindOrAdd(ECommand::SetPaused, Instance).Value = bPaused ? 1.0f : 0.0f;
+    return FMOD_OK;
+}
+
+FMOD_RESULT FFMODCommandBuffer::Start(FMOD::Studio::EventInstance *Instance)
+{
+    if (!ShouldRecord())
+    {
+        return Instance->start();
+    }
+    Add(ECommand::Start, Instance);
+    return FMOD_OK;
+}
+
+FMOD_RESULT FFMODCommandBuffer::Stop(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_STOP_MODE Mode)
+{
+    if (!ShouldRecord())
+    {
+        return Instance->stop(Mode);
+    }
+    Add(ECommand::Stop, Instance).Value = (float)Mode;
+    return FMOD_OK;
+}
+
+FMOD_RESULT FFMODCommandBuffer::Release(FMOD::Studio::EventInstance *Instance)
+{
+    if (!ShouldRecord())
+    {
+        return Instance->release();
+    }
+    Add(ECommand::Release, Instance);
+
+    // Nothing written after the release may be folded into earlier commands
+    for (auto It = CoalescedCommands.CreateIterator(); It; ++It)
+    {
+        if (It.Key().Instance == Instance)
+        {
+            It.RemoveCurrent();
+        }
+    }
+    return FMOD_OK;
+}
+
+void FFMODCommandBuffer::Flush()
+{
+    if (Commands.Num() == 0)
+    {
+        return;
+    }
+
+    for (const FCommand &Command : Commands)
+    {
+        FMOD::Studio::EventInstance *Instance = Command.Instance;
+        FMOD_RESULT Result = FMOD_OK;
+
+        switch (Command.Type)
+        {
+            case ECommand::SetParameterByID:
+                Result = Instance->setParameterByID(Command.ParameterId, Command.Value);
+                break;
+            case ECommand::SetParameterByName:
+                Result = Instance->setParameterByName(&Names[Command.NameOffset], Command.Value);
+                break;
+            case ECommand::Set3DAttributes:
+                Result = Instance->set3DAttributes(&Command.Attributes);
+                break;
+            case ECommand::SetVolume:
+                Result = Instance->setVolume(Command.Value);
+                break;
+            case ECommand::SetPitch:
+                Result = Instance->setPitch(Command.Value);
+                break;
+            case ECommand::SetPaused:
+                Result = Instance->setPaused(Command.Value != 0.0f);
+                break;
+            case ECommand::Start:
+                Result = Instance->start();
+                break;
+            case ECommand::Stop:
+                Result = Instance->stop((FMOD_STUDIO_STOP_MODE)(int)Command.Value);
+                break;
+            case ECommand::Release:
+                Result = Instance->release();
+                break;
+        }
+
+        // Instances often go away before their last calls are replayed, which is harmless
+        if (Result != FMOD_OK && Result != FMOD_ERR_INVALID_HANDLE)
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Deferred call %d on event instance %p failed (%s)"), (int)Command.Type, Instance,
+                UTF8_TO_TCHAR(FMOD_ErrorString(Result)));
+        }
+    }
+
+    Commands.Reset();
+    Names.Reset();
+    CoalescedCommands.Reset();
+}
+
+FFMODCommandBuffer::FCommand &FFMODCommandBuffer::Add(ECommand Type, FMOD::Studio::EventInstance *Instance)
+{
+    FCommand &Command = Commands.AddDefaulted_GetRef();
+    Command.Type = Type;
+    Command.Instance = Instance;
+    Command.ParameterId = FMOD_STUDIO_PARAMETER_ID();
+    Command.NameOffset = INDEX_NONE;
+    Command.Value = 0.0f;
+    return Command;
+}
+
+FFMODCommandBuffer::FCommand &FFMODCommandBuffer::FindOrAdd(
+    ECommand Type, FMOD::Studio::EventInstance *Instance, const FMOD_STUDIO_PARAMETER_ID *Id, const FName &Name)
+{
+    FKey Key;
+    Key.Instance = Instance;
+    Key.Type = Type;
+    Key.ParameterId = Id ? *Id : FMOD_STUDIO_PARAMETER_ID();
+    Key.Name = Name;
+
+    if (const int32 *Index = CoalescedCommands.Find(Key))
+    {
+        return Commands[*Index];
+    }
+
+    CoalescedCommands.Add(Key, Commands.Num());
+    FCommand &Command = Add(Type, Instance);
+    Command.ParameterId = Key.ParameterId;
+
+    if (Type == ECommand::SetParameterByName)
+    {
+        FTCHARToUTF8 Converted(*Name.ToString());
+        Command.NameOffset = Names.Num();
+        Names.Append(Converted.Get(), Converted.Length() + 1);
+    }
+    return Command;
+}
@@ -0,0 +1,109 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "fmod_studio_common.h"
+
+namespace FMOD
+{
+namespace Studio
+{
+class EventInstance;
+}
+}
+
+/**
+ * Records calls that game code makes on event instances during the frame and replays them in one burst just before the
+ * Studio systems update.  Repeated writes to the same instance and parameter, volume, pitch, pause state or 3D attributes
+ * are coalesced, keeping the last value in the place of the first write, so FMOD is only called once per value each frame.
+ * Every replayed call still takes FMOD's API lock.  Values and playback states read back from FMOD don't reflect recorded
+ * calls until they are replayed.
+ * When disabled, or called from another thread, every call goes straight to FMOD.  Game thread only.
+ */
+class FFMODCommandBuffer
+{
+public:
+    FFMODCommandBuffer();
+
+    static FFMODCommandBuffer &Get();
+
+    /** Start or stop recording calls, replaying anything already recorded when disabled */
+    void SetEnabled(bool bInEnabled);
+    bool IsEnabled() const { return bEnabled; }
+
+    /** Equivalents of the event instance functions, returning FMOD_OK when the call is recorded */
+    FMOD_RESULT SetParameterByID(FMOD::Studio::EventInstance *Instance, const FMOD_STUDIO_PARAMETER_ID &Id, float Value);
+    FMOD_RESULT SetParameterByName(FMOD::Studio::EventInstance *Instance, const FName &Name, float Value);
+    FMOD_RESULT Set3DAttributes(FMOD::Studio::EventInstance *Instance, const FMOD_3D_ATTRIBUTES &Attributes);
+    FMOD_RESULT SetVolume(FMOD::Studio::EventInstance *Instance, float Volume);
+    FMOD_RESULT SetPitch(FMOD::Studio::EventInstance *Instance, float Pitch);
+    FMOD_RESULT SetPaused(FMOD::Studio::EventInstance *Instance, bool bPaused);
+    FMOD_RESULT Start(FMOD::Studio::EventInstance *Instance);
+    FMOD_RESULT Stop(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_STOP_MODE Mode);
+    FMOD_RESULT Release(FMOD::Studio::EventInstance *Instance);
+
+    /** Replay every recorded call in the order it was first made */
+    void Flush();
+
+private:
+    enum class ECommand : uint8
+    {
+        SetParameterByID,
+        SetParameterByName,
+        Set3DAttributes,
+        SetVolume,
+        SetPitch,
+        SetPaused,
+        Start,
+        Stop,
+        Release
+    };
+
+    struct FCommand
+    {
+        ECommand Type;
+        FMOD::Studio::EventInstance *Instance;
+        FMOD_STUDIO_PARAMETER_ID ParameterId;
+        int32 NameOffset;
+        float Value;
+        FMOD_3D_ATTRIBUTES Attributes;
+    };
+
+    // Identifies the value a coalesced command writes
+    struct FKey
+    {
+        FMOD::Studio::EventInstance *Instance;
+        ECommand Type;
+        FMOD_STUDIO_PARAMETER_ID ParameterId;
+        FName Name;
+
+        bool operator==(const FKey &Other) const
+        {
+            return Instance == Other.Instance && Type == Other.Type && ParameterId.data1 == Other.ParameterId.data1 &&
+                   ParameterId.data2 == Other.ParameterId.data2 && Name == Other.Name;
+        }
+
+        friend uint32 GetTypeHash(const FKey &Key)
+        {
+            uint32 Hash = HashCombine(PointerHash(Key.Instance), (uint32)Key.Type);
+            Hash = HashCombine(Hash, HashCombine(Key.ParameterId.data1, Key.ParameterId.data2));
+            return HashCombine(Hash, GetTypeHash(Key.Name));
+        }
+    };
+
+    bool ShouldRecord() const { return bEnabled && IsInGameThread(); }
+
+    /** Add a command that always runs in order, such as start or stop */
+    FCommand &Add(ECommand Type, FMOD::Studio::EventInstance *Instance);
+
+    /** Find the command already writing the same value this frame, or add a new one */
+    FCommand &FindOrAdd(ECommand Type, FMOD::Studio::EventInstance *Instance, const FMOD_STUDIO_PARAMETER_ID *Id = nullptr, const FName &Name = NAME_None);
+
+    bool bEnabled;
+
+    // Storage is kept between frames, so recording doesn't allocate once it has grown to a typical frame's worth
+    TArray<FCommand> Commands;
+    TArray<ANSICHAR> Names;
+    TMap<FKey, int32> CoalescedCommands;
+};
@@ -0,0 +1,111 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODEmitterManager.h"
+#include "FMODAudioComponent.h"
+#include "FMODSettings.h"
+#include "FMODStudioPrivatePCH.h"
+#include "GameFramework/Actor.h"
+
+FFMODEmitterManager &FFMODEmitterManager::Get()
+{
+    static FFMODEmitterManager Instance;
+    return Instance;
+}
+
+void FFMODEmitterManager::MarkDirty(UFMODAudioComponent *Component)
+{
+    if (Component->bTransformDirty)
+    {
+        return;
+    }
+
+    // Small moves are accumulated until they add up to something audible
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    const FTransform &Transform = Component->GetComponentTransform();
+    const FTransform &LastTransform = Component->LastSubmittedTransform;
+    if (FVector::DistSquared(Transform.GetLocation(), LastTransform.GetLocation()) < FMath::Square(Settings.EmitterMoveThreshold) &&
+        Transform.GetRotation().AngularDistance(LastTransform.GetRotation()) < FMath::DegreesToRadians(Settings.EmitterRotationThreshold))
+    {
+        return;
+    }
+
+    Worlds.FindOrAdd(Component->GetWorld()).DirtyComponents.Add(Component);
+    Component->bTransformDirty = true;
+}
+
+void FFMODEmitterManager::Flush()
+{
+    for (TMap<TWeakObjectPtr<UWorld>, FWorldEmitters>::TIterator It(Worlds); It; ++It)
+    {
+        if (!It.Key().IsValid())
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        TArray<TWeakObjectPtr<UFMODAudioComponent>> &DirtyComponents = It.Value().DirtyComponents;
+        if (DirtyComponents.Num() == 0)
+        {
+            continue;
+        }
+
+        FlushComponents.Reset();
+        FlushTransforms.Reset();
+        FlushVelocities.Reset();
+
+        for (const TWeakObjectPtr<UFMODAudioComponent> &WeakComponent : DirtyComponents)
+        {
+            UFMODAudioComponent *Component = WeakComponent.Get();
+            if (Component == nullptr)
+            {
+                continue;
+            }
+            if (Component->StudioInstance == nullptr)
+            {
+                Component->bTransformDirty = false;
+                continue;
+            }
+
+            AActor *Owner = Component->GetOwner();
+            FlushComponents.Add(Component);
+            FlushTransforms.Add(Component->GetComponentTransform());
+            FlushVelocities.Add(Owner ? Owner->GetVelocity() : FVector::ZeroVector);
+        }
+        DirtyComponents.Reset();
+
+        FlushAttributes.SetNumUninitialized(FlushComponents.Num(), false);
+        ConvertAttributes(FlushTransforms.GetData(), FlushVelocities.GetData(), FlushAttributes.GetData(), FlushComponents.Num());
+
+        for (int32 i = 0; i < FlushComponents.Num(); ++i)
+        {
+            FlushComponents[i]->LastSubmittedTransform = FlushTransforms[i];
+            FlushComponents[i]->Apply3DAttributes(FlushAttributes[i]);
+        }
+    }
+}
+
+void FFMODEmitterManager::ConvertAttributes(const FTransform *Transforms, const FVector *Velocities, FMOD_3D_ATTRIBUTES *OutAttributes, int32 Count)
+{
+    // FMOD is Y up and measured in metres, so FMOD (x, y, z) is UE4 (Y, Z, X) scaled down from centimetres
+    const VectorRegister Scale = VectorSetFloat1(FMOD_VECTOR_SCALE_DEFAULT);
+    const VectorRegister UnitX = MakeVectorRegister(1.0f, 0.0f, 0.0f, 0.0f);
+    const VectorRegister UnitZ = MakeVectorRegister(0.0f, 0.0f, 1.0f, 0.0f);
+
+    for (int32 i = 0; i < Count; ++i)
+    {
+        const FQuat Rotation = Transforms[i].GetRotation();
+        const FVector Location = Transforms[i].GetLocation();
+        const VectorRegister RotationReg = VectorLoadAligned(&Rotation);
+
+        VectorRegister Position = VectorMultiply(VectorSwizzle(VectorLoadFloat3(&Location), 1, 2, 0, 3), Scale);
+        VectorRegister Velocity = VectorMultiply(VectorSwizzle(VectorLoadFloat3(&Velocities[i]), 1, 2, 0, 3), Scale);
+        VectorRegister Forward = VectorSwizzle(VectorQuaternionRotateVector(RotationReg, UnitX), 1, 2, 0, 3);
+        VectorRegister Up = VectorSwizzle(VectorQuaternionRotateVector(RotationReg, UnitZ), 1, 2, 0, 3);
+
+        FMOD_3D_ATTRIBUTES &Attributes = OutAttributes[i];
+        VectorStoreFloat3(Position, &Attributes.position);
+        VectorStoreFloat3(Velocity, &Attributes.velocity);
+        VectorStoreFloat3(Forward, &Attributes.forward);
+        VectorStoreFloat3(Up, &Attributes.up);
+    }
+}
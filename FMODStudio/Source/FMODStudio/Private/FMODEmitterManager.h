@@ -0,0 +1,44 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "fmod_common.h"
+
+class UFMODAudioComponent;
+class UWorld;
+
+/**
+ * Collects FMOD audio components whose transform changed during the frame and submits their 3D attributes in one
+ * pass just before the Studio system update, instead of calling into FMOD on every transform change.
+ * Emitters are bucketed per world.  Must only be used from the game thread.
+ */
+class FFMODEmitterManager
+{
+public:
+    static FFMODEmitterManager &Get();
+
+    /** Queue a component for the next flush, unless it moved less than the configured thresholds since it was last submitted */
+    void MarkDirty(UFMODAudioComponent *Component);
+
+    /** Submit 3D attributes for every dirty component */
+    void Flush();
+
+    /** Convert transforms and velocities in UE4 space into FMOD 3D attributes */
+    static void ConvertAttributes(const FTransform *Transforms, const FVector *Velocities, FMOD_3D_ATTRIBUTES *OutAttributes, int32 Count);
+
+private:
+    struct FWorldEmitters
+    {
+        TArray<TWeakObjectPtr<UFMODAudioComponent>> DirtyComponents;
+    };
+
+    TMap<TWeakObjectPtr<UWorld>, FWorldEmitters> Worlds;
+
+    // Scratch space reused between flushes
+    TArray<UFMODAudioComponent *> FlushComponents;
+    TArray<FTransform> FlushTransforms;
+    TArray<FVector> FlushVelocities;
+    TArray<FMOD_3D_ATTRIBUTES> FlushAttributes;
+};
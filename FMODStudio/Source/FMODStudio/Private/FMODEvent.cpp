@@ -6,6 +6,8 @@
 
 UFMODEvent::UFMODEvent(const FObjectInitializer &ObjectInitializer)
     : Super(ObjectInitializer)
+    , bPoolInstances(false)
+    , PoolPrewarmSize(0)
 {
 }
 
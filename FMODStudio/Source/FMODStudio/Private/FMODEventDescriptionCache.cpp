@@ -0,0 +1,108 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODEventDescriptionCache.h"
+#include "FMODStudioPrivatePCH.h"
+#include "Misc/ScopeLock.h"
+
+FFMODEventDescriptionCache::FFMODEventDescriptionCache()
+    : Generation(0)
+{
+}
+
+FFMODEventDescriptionCache &FFMODEventDescriptionCache::Get()
+{
+    static FFMODEventDescriptionCache Instance;
+    return Instance;
+}
+
+FFMODEventDescriptionInfoPtr FFMODEventDescriptionCache::Find(FMOD::Studio::EventDescription *Description)
+{
+    if (Description == nullptr)
+    {
+        return nullptr;
+    }
+
+    uint32 StartGeneration;
+    {
+        FScopeLock Lock(&Crit);
+
+        const FFMODEventDescriptionInfoPtr *Existing = Entries.Find(Description);
+        if (Existing)
+        {
+            return *Existing;
+        }
+        StartGeneration = Generation;
+    }
+
+    // Query FMOD outside the lock, as bank unload callbacks can come in on FMOD's threads meanwhile
+    TSharedPtr<FFMODEventDescriptionInfo, ESPMode::ThreadSafe> Info = MakeShared<FFMODEventDescriptionInfo, ESPMode::ThreadSafe>();
+
+    int ParameterCount = 0;
+    if (Description->getParameterDescriptionCount(&ParameterCount) == FMOD_OK)
+    {
+        Info->ParameterIds.Reserve(ParameterCount);
+        for (int ParameterIdx = 0; ParameterIdx < ParameterCount; ++ParameterIdx)
+        {
+            FMOD_STUDIO_PARAMETER_DESCRIPTION ParameterDescription = {};
+            if (Description->getParameterDescriptionByIndex(ParameterIdx, &ParameterDescription) == FMOD_OK)
+            {
+                Info->ParameterIds.Add(FName(UTF8_TO_TCHAR(ParameterDescription.name)), ParameterDescription.id);
+
+                const FMOD_STUDIO_PARAMETER_FLAGS NotSettable =
+                    FMOD_STUDIO_PARAMETER_READONLY | FMOD_STUDIO_PARAMETER_AUTOMATIC | FMOD_STUDIO_PARAMETER_GLOBAL;
+                if ((ParameterDescription.flags & NotSettable) == 0)
+                {
+                    Info->DefaultParameterIds.Add(ParameterDescription.id);
+                    Info->DefaultParameterValues.Add(ParameterDescription.defaultvalue);
+                }
+            }
+        }
+    }
+
+    int Length = 0;
+    Description->getLength(&Length);
+    Info->Length = Length;
+    Description->is3D(&Info->bIs3D);
+    Description->isOneshot(&Info->bOneshot);
+    Description->getMinimumDistance(&Info->MinimumDistance);
+    Description->getMaximumDistance(&Info->MaximumDistance);
+
+    FScopeLock Lock(&Crit);
+
+    // A bank was unloaded while we were reading, so the description may already be gone
+    if (Generation == StartGeneration)
+    {
+        Entries.Add(Description, Info);
+    }
+    return Info;
+}
+
+FFMODEventDescriptionInfoPtr FFMODEventDescriptionCache::Find(FMOD::Studio::EventInstance *Instance)
+{
+    FMOD::Studio::EventDescription *Description = nullptr;
+    if (Instance == nullptr || Instance->getDescription(&Description) != FMOD_OK)
+    {
+        return nullptr;
+    }
+    return Find(Description);
+}
+
+bool FFMODEventDescriptionCache::FindParameterId(FMOD::Studio::EventInstance *Instance, const FName &Name, FMOD_STUDIO_PARAMETER_ID &OutId)
+{
+    FFMODEventDescriptionInfoPtr Info = Find(Instance);
+    const FMOD_STUDIO_PARAMETER_ID *Id = Info.IsValid() ? Info->FindParameterId(Name) : nullptr;
+    if (Id)
+    {
+        OutId = *Id;
+        return true;
+    }
+    return false;
+}
+
+void FFMODEventDescriptionCache::Invalidate()
+{
+    FScopeLock Lock(&Crit);
+
+    Entries.Empty();
+    ++Generation;
+}
@@ -0,0 +1,72 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "fmod_studio.hpp"
+
+/** Metadata about an event description that can't change while its bank stays loaded */
+struct FFMODEventDescriptionInfo
+{
+    FFMODEventDescriptionInfo()
+        : Length(0)
+        , bIs3D(false)
+        , bOneshot(false)
+        , MinimumDistance(0.0f)
+        , MaximumDistance(0.0f)
+    {
+    }
+
+    const FMOD_STUDIO_PARAMETER_ID *FindParameterId(const FName &Name) const { return ParameterIds.Find(Name); }
+
+    /** Whether an instance can set the parameter, rather than it being read only, automatic or global */
+    bool IsSettable(const FMOD_STUDIO_PARAMETER_ID &Id) const
+    {
+        return DefaultParameterIds.ContainsByPredicate(
+            [&Id](const FMOD_STUDIO_PARAMETER_ID &Other) { return Other.data1 == Id.data1 && Other.data2 == Id.data2; });
+    }
+
+    TMap<FName, FMOD_STUDIO_PARAMETER_ID> ParameterIds;
+
+    /** Local, user settable parameters and their default values, for restoring a reused instance */
+    TArray<FMOD_STUDIO_PARAMETER_ID> DefaultParameterIds;
+    TArray<float> DefaultParameterValues;
+
+    int32 Length;
+    bool bIs3D;
+    bool bOneshot;
+    float MinimumDistance;
+    float MaximumDistance;
+};
+
+typedef TSharedPtr<const FFMODEventDescriptionInfo, ESPMode::ThreadSafe> FFMODEventDescriptionInfoPtr;
+
+/**
+ * Caches parameter ids and other metadata per event description, so that playing events and setting parameters by
+ * name doesn't go through FMOD's string lookups every time.  Everything is dropped whenever a bank is unloaded,
+ * since the descriptions it held become invalid and their addresses may be reused.
+ */
+class FFMODEventDescriptionCache
+{
+public:
+    FFMODEventDescriptionCache();
+
+    static FFMODEventDescriptionCache &Get();
+
+    /** Returns the metadata for a description, reading it from FMOD on first use */
+    FFMODEventDescriptionInfoPtr Find(FMOD::Studio::EventDescription *Description);
+
+    /** Returns the metadata for the description an instance was created from */
+    FFMODEventDescriptionInfoPtr Find(FMOD::Studio::EventInstance *Instance);
+
+    /** Looks up the id of a parameter on an instance's description */
+    bool FindParameterId(FMOD::Studio::EventInstance *Instance, const FName &Name, FMOD_STUDIO_PARAMETER_ID &OutId);
+
+    /** Forget everything.  Safe to call from FMOD callbacks. */
+    void Invalidate();
+
+private:
+    FCriticalSection Crit;
+    TMap<FMOD::Studio::EventDescription *, FFMODEventDescriptionInfoPtr> Entries;
+    uint32 Generation;
+};
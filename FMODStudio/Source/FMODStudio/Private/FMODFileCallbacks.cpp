@@ -42,6 +42,283 @@ FMOD_RESULT F_CALLBACK FMODLogCallback(FMOD_DEBUG_FLAGS flags, const char *file,
     return FMOD_OK;
 }
 
+class FFMODAsyncFileReader
+{
+public:
+    FFMODAsyncFileReader()
+        : mStopRequested(false)
+        , mWorkReadyEvent(nullptr)
+    {
+    }
+
+    static FMOD_RESULT F_CALLBACK OpenCallback(const char *name, unsigned int *filesize, void **handle, void * /*userdata*/);
+    static FMOD_RESULT F_CALLBACK CloseCallback(void *handle, void * /*userdata*/);
+    static FMOD_RESULT F_CALLBACK ReadCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/);
+    static FMOD_RESULT F_CALLBACK CancelCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/);
+
+    bool IsRunning() const { return mWorkers.Num() > 0; }
+
+    void Start(int32 threadCount)
+    {
+        check(!IsRunning());
+
+        mStopRequested = false;
+        mWorkReadyEvent = FGenericPlatformProcess::GetSynchEventFromPool();
+
+        for (int32 i = 0; i < FMath::Max(threadCount, 1); ++i)
+        {
+            FWorker *Worker = new FWorker(*this);
+            Worker->mThread = FRunnableThread::Create(Worker, *FString::Printf(TEXT("FMOD Async File Reader %d"), i));
+            mWorkers.Add(Worker);
+        }
+    }
+
+    void Stop()
+    {
+        if (!IsRunning())
+        {
+            return;
+        }
+
+        {
+            FScopeLock lock(&mCrit);
+            check(mPending.Num() == 0 && mInFlight.Num() == 0);
+            mStopRequested = true;
+        }
+
+        mWorkReadyEvent->Trigger();
+
+        for (FWorker *Worker : mWorkers)
+        {
+            Worker->mThread->WaitForCompletion();
+            delete Worker->mThread;
+            delete Worker;
+        }
+        mWorkers.Reset();
+
+        FGenericPlatformProcess::ReturnSynchEventToPool(mWorkReadyEvent);
+        mWorkReadyEvent = nullptr;
+    }
+
+private:
+    // Each handle carries its own lock so that reads on different files can proceed in parallel
+    struct FHandle
+    {
+        FArchive *Archive;
+        FCriticalSection Crit;
+    };
+
+    class FWorker : public FRunnable
+    {
+    public:
+        FWorker(FFMODAsyncFileReader &reader)
+            : mReader(reader)
+            , mThread(nullptr)
+        {
+        }
+
+        uint32 Run() override
+        {
+            FMOD_ASYNCREADINFO *info = nullptr;
+
+            while (mReader.WaitForRequest(info))
+            {
+                FMOD_RESULT result = ReadInternal((FHandle *)info->handle, info);
+
+                // FMOD may free the request as soon as it is signalled, so only then stop tracking it
+                info->done(info, result);
+                mReader.CompleteRequest(info);
+            }
+
+            return 0;
+        }
+
+        FFMODAsyncFileReader &mReader;
+        FRunnableThread *mThread;
+    };
+
+    static FMOD_RESULT ReadInternal(FHandle *handle, FMOD_ASYNCREADINFO *info);
+
+    bool WaitForRequest(FMOD_ASYNCREADINFO *&info)
+    {
+        for (;;)
+        {
+            {
+                FScopeLock lock(&mCrit);
+
+                if (mStopRequested)
+                {
+                    // Pass the wake up on to the next worker
+                    mWorkReadyEvent->Trigger();
+                    return false;
+                }
+
+                if (mPending.Num() > 0)
+                {
+                    info = mPending[0];
+                    mPending.RemoveAt(0, 1, false);
+                    mInFlight.Add(info);
+
+                    if (mPending.Num() > 0)
+                    {
+                        // Wake another worker for the remaining requests
+                        mWorkReadyEvent->Trigger();
+                    }
+                    return true;
+                }
+            }
+
+            mWorkReadyEvent->Wait();
+        }
+    }
+
+    void CompleteRequest(FMOD_ASYNCREADINFO *info)
+    {
+        FScopeLock lock(&mCrit);
+        mInFlight.RemoveSingleSwap(info, false);
+    }
+
+    void QueueRequest(FMOD_ASYNCREADINFO *info)
+    {
+        {
+            FScopeLock lock(&mCrit);
+
+            // Keep the queue ordered by priority, first come first served within a priority
+            int32 index = mPending.IndexOfByPredicate([info](const FMOD_ASYNCREADINFO *other) { return other->priority < info->priority; });
+            if (index == INDEX_NONE)
+            {
+                mPending.Add(info);
+            }
+            else
+            {
+                mPending.Insert(info, index);
+            }
+        }
+
+        mWorkReadyEvent->Trigger();
+    }
+
+    FMOD_RESULT CancelRequest(FMOD_ASYNCREADINFO *info)
+    {
+        {
+            FScopeLock lock(&mCrit);
+
+            if (mPending.RemoveSingle(info) > 0)
+            {
+                info->done(info, FMOD_ERR_FILE_DISKEJECTED);
+                return FMOD_OK;
+            }
+        }
+
+        // Already being serviced, FMOD expects the request to be finished before we return
+        for (;;)
+        {
+            {
+                FScopeLock lock(&mCrit);
+
+                if (!mInFlight.Contains(info))
+                {
+                    break;
+                }
+            }
+
+            FPlatformProcess::Sleep(0.0f);
+        }
+
+        return FMOD_OK;
+    }
+
+    TArray<FMOD_ASYNCREADINFO *> mPending;
+    TArray<FMOD_ASYNCREADINFO *> mInFlight;
+    TArray<FWorker *> mWorkers;
+    bool mStopRequested;
+    FEvent *mWorkReadyEvent;
+
+    FCriticalSection mCrit;
+};
+
+static FFMODAsyncFileReader gAsyncFileReader;
+
+FMOD_RESULT F_CALLBACK FFMODAsyncFileReader::OpenCallback(const char *name, unsigned int *filesize, void **handle, void * /*userdata*/)
+{
+    if (name)
+    {
+        FArchive *Archive = IFileManager::Get().CreateFileReader(UTF8_TO_TCHAR(name));
+        UE_LOG(LogFMOD, Verbose, TEXT("FFMODAsyncFileReader::OpenCallback opening '%s' returned archive %p"), UTF8_TO_TCHAR(name), Archive);
+        if (!Archive)
+        {
+            return FMOD_ERR_FILE_NOTFOUND;
+        }
+
+        FHandle *Handle = new FHandle;
+        Handle->Archive = Archive;
+
+        *filesize = Archive->TotalSize();
+        *handle = Handle;
+    }
+
+    return FMOD_OK;
+}
+
+FMOD_RESULT F_CALLBACK FFMODAsyncFileReader::CloseCallback(void *handle, void * /*userdata*/)
+{
+    if (!handle)
+    {
+        return FMOD_ERR_INVALID_PARAM;
+    }
+
+    FHandle *Handle = (FHandle *)handle;
+    UE_LOG(LogFMOD, Verbose, TEXT("FFMODAsyncFileReader::CloseCallback closing archive %p"), Handle->Archive);
+    delete Handle->Archive;
+    delete Handle;
+
+    return FMOD_OK;
+}
+
+FMOD_RESULT F_CALLBACK FFMODAsyncFileReader::ReadCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/)
+{
+    if (!info->handle)
+    {
+        return FMOD_ERR_INVALID_PARAM;
+    }
+
+    gAsyncFileReader.QueueRequest(info);
+
+    return FMOD_OK;
+}
+
+FMOD_RESULT F_CALLBACK FFMODAsyncFileReader::CancelCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/)
+{
+    return gAsyncFileReader.CancelRequest(info);
+}
+
+FMOD_RESULT FFMODAsyncFileReader::ReadInternal(FHandle *handle, FMOD_ASYNCREADINFO *info)
+{
+    FScopeLock lock(&handle->Crit);
+
+    FArchive *Archive = handle->Archive;
+
+    int64 BytesLeft = Archive->TotalSize() - (int64)info->offset;
+    int64 ReadAmount = FMath::Clamp((int64)info->sizebytes, (int64)0, BytesLeft);
+
+    Archive->Seek(info->offset);
+    Archive->Serialize(info->buffer, ReadAmount);
+    info->bytesread = (unsigned int)ReadAmount;
+
+    if (Archive->IsError())
+    {
+        return FMOD_ERR_FILE_BAD;
+    }
+
+    if (ReadAmount < (int64)info->sizebytes)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT(" -> EOF "));
+        return FMOD_ERR_FILE_EOF;
+    }
+
+    return FMOD_OK;
+}
+
 class FFMODFileSystem : public FRunnable
 {
 public:
@@ -100,6 +377,8 @@ public:
 
         if (mReferenceCount == 0)
         {
+            gAsyncFileReader.Stop();
+
             verifyfmod(RunCommand(COMMAND_STOP));
             mThread->WaitForCompletion();
 
@@ -112,11 +391,28 @@ public:
         }
     }
 
-    void Attach(FMOD::System *system, int32 fileBufferSize)
+    void Attach(FMOD::System *system, int32 fileBufferSize, int32 asyncReadThreads)
     {
         check(mThread);
 
-        verifyfmod(system->setFileSystem(OpenCallback, CloseCallback, ReadCallback, SeekCallback, 0, 0, fileBufferSize));
+        if (asyncReadThreads > 0)
+        {
+            {
+                FScopeLock lock(&mCrit);
+
+                if (!gAsyncFileReader.IsRunning())
+                {
+                    gAsyncFileReader.Start(asyncReadThreads);
+                }
+            }
+
+            verifyfmod(system->setFileSystem(FFMODAsyncFileReader::OpenCallback, FFMODAsyncFileReader::CloseCallback, 0, 0,
+                FFMODAsyncFileReader::ReadCallback, FFMODAsyncFileReader::CancelCallback, fileBufferSize));
+        }
+        else
+        {
+            verifyfmod(system->setFileSystem(OpenCallback, CloseCallback, ReadCallback, SeekCallback, 0, 0, fileBufferSize));
+        }
     }
 
     uint32 Run() override
@@ -323,7 +619,7 @@ void ReleaseFMODFileSystem()
     gFileSystem.DecrementReferenceCount();
 }
 
-void AttachFMODFileSystem(FMOD::System *system, int32 fileBufferSize)
+void AttachFMODFileSystem(FMOD::System *system, int32 fileBufferSize, int32 asyncReadThreads)
 {
-    gFileSystem.Attach(system, fileBufferSize);
+    gFileSystem.Attach(system, fileBufferSize, asyncReadThreads);
 }
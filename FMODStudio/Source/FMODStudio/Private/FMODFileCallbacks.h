@@ -9,4 +9,4 @@ FMOD_RESULT F_CALLBACK FMODLogCallback(FMOD_DEBUG_FLAGS flags, const char *file,
 
 void AcquireFMODFileSystem();
 void ReleaseFMODFileSystem();
-void AttachFMODFileSystem(FMOD::System *system, FGenericPlatformTypes::int32 fileBufferSize);
+void AttachFMODFileSystem(FMOD::System *system, FGenericPlatformTypes::int32 fileBufferSize, FGenericPlatformTypes::int32 asyncReadThreads = 0);
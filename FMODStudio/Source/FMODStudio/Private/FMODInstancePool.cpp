@@ -0,0 +1,138 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODInstancePool.h"
+#include "FMODCommandBuffer.h"
+#include "FMODEventDescriptionCache.h"
+#include "FMODStudioPrivatePCH.h"
+
+FFMODInstancePool &FFMODInstancePool::Get()
+{
+    static FFMODInstancePool Instance;
+    return Instance;
+}
+
+FMOD::Studio::EventInstance *FFMODInstancePool::Acquire(FMOD::Studio::EventDescription *Description)
+{
+    FPool &Pool = Pools.FindOrAdd(Description);
+    while (Pool.Free.Num() > 0)
+    {
+        FMOD::Studio::EventInstance *Instance = Pool.Free.Pop(false);
+        if (Instance->isValid())
+        {
+            return Instance;
+        }
+    }
+
+    FMOD::Studio::EventInstance *Instance = nullptr;
+    Description->createInstance(&Instance);
+    return Instance;
+}
+
+void FFMODInstancePool::Play(FMOD::Studio::EventDescription *Description, FMOD::Studio::EventInstance *Instance)
+{
+    FFMODCommandBuffer::Get().Start(Instance);
+    Pools.FindOrAdd(Description).Playing.Add(Instance);
+}
+
+void FFMODInstancePool::Prewarm(FMOD::Studio::EventDescription *Description, int32 Count)
+{
+    FPool &Pool = Pools.FindOrAdd(Description);
+    while (Pool.Free.Num() < Count)
+    {
+        FMOD::Studio::EventInstance *Instance = nullptr;
+        if (Description->createInstance(&Instance) != FMOD_OK)
+        {
+            break;
+        }
+        Pool.Free.Add(Instance);
+    }
+}
+
+void FFMODInstancePool::Drain(FMOD::Studio::EventDescription *Description)
+{
+    FPool *Pool = Pools.Find(Description);
+    if (Pool)
+    {
+        for (FMOD::Studio::EventInstance *Instance : Pool->Free)
+        {
+            Instance->release();
+        }
+        Pool->Free.Reset();
+
+        // FMOD frees playing instances once they stop
+        for (FMOD::Studio::EventInstance *Instance : Pool->Playing)
+        {
+            Instance->release();
+        }
+        Pools.Remove(Description);
+    }
+}
+
+void FFMODInstancePool::Update()
+{
+    for (TMap<FMOD::Studio::EventDescription *, FPool>::TIterator It(Pools); It; ++It)
+    {
+        // The bank holding the event was unloaded, taking the instances with it
+        if (!It.Key()->isValid())
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        FPool &Pool = It.Value();
+        for (int32 i = Pool.Playing.Num() - 1; i >= 0; --i)
+        {
+            FMOD::Studio::EventInstance *Instance = Pool.Playing[i];
+            FMOD_STUDIO_PLAYBACK_STATE State = FMOD_STUDIO_PLAYBACK_STOPPED;
+            if (Instance->getPlaybackState(&State) != FMOD_OK)
+            {
+                // Released by someone else
+                Pool.Playing.RemoveAtSwap(i, 1, false);
+            }
+            else if (State == FMOD_STUDIO_PLAYBACK_STOPPED)
+            {
+                Pool.Playing.RemoveAtSwap(i, 1, false);
+                ResetInstance(It.Key(), Instance);
+                Pool.Free.Add(Instance);
+            }
+        }
+    }
+}
+
+void FFMODInstancePool::Reset()
+{
+    for (TPair<FMOD::Studio::EventDescription *, FPool> &Pool : Pools)
+    {
+        for (FMOD::Studio::EventInstance *Instance : Pool.Value.Free)
+        {
+            Instance->release();
+        }
+        for (FMOD::Studio::EventInstance *Instance : Pool.Value.Playing)
+        {
+            Instance->release();
+        }
+    }
+    Pools.Reset();
+}
+
+void FFMODInstancePool::ResetInstance(FMOD::Studio::EventDescription *Description, FMOD::Studio::EventInstance *Instance)
+{
+    // Safe to call directly, the command buffer is flushed before Update and nothing else records calls on pooled instances
+
+    FFMODEventDescriptionInfoPtr Info = FFMODEventDescriptionCache::Get().Find(Description);
+    if (Info.IsValid() && Info->DefaultParameterIds.Num() > 0)
+    {
+        TArray<float, TInlineAllocator<16>> Values(Info->DefaultParameterValues);
+        Instance->setParametersByIDs(Info->DefaultParameterIds.GetData(), Values.GetData(), Values.Num(), true);
+    }
+
+    for (int i = 0; i < FMOD_STUDIO_EVENT_PROPERTY_MAX; ++i)
+    {
+        Instance->setProperty((FMOD_STUDIO_EVENT_PROPERTY)i, -1.0f);
+    }
+    Instance->setVolume(1.0f);
+    Instance->setPitch(1.0f);
+    Instance->setPaused(false);
+    Instance->setCallback(nullptr);
+    Instance->setUserData(nullptr);
+}
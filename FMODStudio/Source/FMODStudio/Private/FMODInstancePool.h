@@ -0,0 +1,46 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "fmod_studio.hpp"
+
+/**
+ * Reuses stopped fire and forget event instances for events that have pooling enabled, to avoid creating and
+ * releasing an instance inside FMOD for every one shot.  Pooled instances are owned by the pool: they are handed
+ * out already started and are reclaimed once they stop.  Must only be used from the game thread.
+ */
+class FFMODInstancePool
+{
+public:
+    static FFMODInstancePool &Get();
+
+    /** Returns a stopped instance with default parameters and properties, creating one if none are free */
+    FMOD::Studio::EventInstance *Acquire(FMOD::Studio::EventDescription *Description);
+
+    /** Hands an instance acquired from the pool back, to be reclaimed once it has stopped */
+    void Play(FMOD::Studio::EventDescription *Description, FMOD::Studio::EventInstance *Instance);
+
+    /** Makes sure at least Count free instances exist for the description */
+    void Prewarm(FMOD::Studio::EventDescription *Description, int32 Count);
+
+    /** Releases the free instances for a description and stops pooling new ones */
+    void Drain(FMOD::Studio::EventDescription *Description);
+
+    /** Reclaims instances that have stopped playing.  Called once per frame. */
+    void Update();
+
+    /** Releases every pooled instance, letting playing ones finish.  Called when a Studio system is going away. */
+    void Reset();
+
+private:
+    struct FPool
+    {
+        TArray<FMOD::Studio::EventInstance *> Free;
+        TArray<FMOD::Studio::EventInstance *> Playing;
+    };
+
+    void ResetInstance(FMOD::Studio::EventDescription *Description, FMOD::Studio::EventInstance *Instance);
+
+    TMap<FMOD::Studio::EventDescription *, FPool> Pools;
+};
@@ -0,0 +1,8 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODLevelBankManifest.h"
+
+UFMODLevelBankManifest::UFMODLevelBankManifest(const FObjectInitializer &ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+}
@@ -0,0 +1,250 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODLevelPreloader.h"
+#include "FMODBank.h"
+#include "FMODBankManager.h"
+#include "FMODEvent.h"
+#include "FMODLevelBankManifest.h"
+#include "FMODSettings.h"
+#include "FMODStudioModule.h"
+#include "FMODUtils.h"
+#include "Engine/Level.h"
+#include "fmod_studio.hpp"
+#include "FMODStudioPrivatePCH.h"
+
+FFMODLevelPreloader &FFMODLevelPreloader::Get()
+{
+    static FFMODLevelPreloader Instance;
+    return Instance;
+}
+
+void FFMODLevelPreloader::Startup()
+{
+    PostWorldInitializationHandle = FWorldDelegates::OnPostWorldInitialization.AddRaw(this, &FFMODLevelPreloader::HandlePostWorldInitialization);
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FFMODLevelPreloader::HandleWorldCleanup);
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FFMODLevelPreloader::HandleLevelAdded);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FFMODLevelPreloader::HandleLevelRemoved);
+}
+
+void FFMODLevelPreloader::Shutdown()
+{
+    FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldInitializationHandle);
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+    Levels.Reset();
+}
+
+void FFMODLevelPreloader::Update()
+{
+    if (Levels.Num() == 0)
+    {
+        return;
+    }
+
+    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
+    if (!StudioSystem)
+    {
+        return;
+    }
+
+    for (TPair<TObjectKey<ULevel>, FLevelEntry> &Pair : Levels)
+    {
+        FLevelEntry &Entry = Pair.Value;
+
+        if (!Entry.bAcquired)
+        {
+            Acquire(Entry);
+        }
+
+        if (Entry.PendingEvents.Num() == 0)
+        {
+            continue;
+        }
+
+        // Event descriptions can only be found once their banks' metadata has loaded
+        bool bBanksLoading = false;
+        for (const TWeakObjectPtr<UFMODBank> &Bank : Entry.Banks)
+        {
+            FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Bank.IsValid() ? Bank->AssetGuid : FGuid());
+            FMOD::Studio::Bank *StudioBank = nullptr;
+            FMOD_STUDIO_LOADING_STATE State = FMOD_STUDIO_LOADING_STATE_ERROR;
+
+            if (Bank.IsValid() && StudioSystem->getBankByID(&Guid, &StudioBank) == FMOD_OK && StudioBank->getLoadingState(&State) == FMOD_OK &&
+                State == FMOD_STUDIO_LOADING_STATE_LOADING)
+            {
+                bBanksLoading = true;
+                break;
+            }
+        }
+
+        if (bBanksLoading)
+        {
+            continue;
+        }
+
+        for (const TWeakObjectPtr<UFMODEvent> &Event : Entry.PendingEvents)
+        {
+            FMOD::Studio::EventDescription *EventDesc = IFMODStudioModule::Get().GetEventDescription(Event.Get(), EFMODSystemContext::Runtime);
+            if (EventDesc)
+            {
+                verifyfmod(EventDesc->loadSampleData());
+                Entry.LoadedEvents.Add(EventDesc);
+            }
+            else
+            {
+                UE_LOG(LogFMOD, Verbose, TEXT("Level event %s is not in any loaded bank"), Event.IsValid() ? *Event->GetName() : TEXT("(null)"));
+            }
+        }
+        Entry.PendingEvents.Reset();
+    }
+}
+
+void FFMODLevelPreloader::Reset(bool bReleaseLoaded)
+{
+    // The banks and sample data go away with the system, so only remember to acquire them again on the next one
+    for (TPair<TObjectKey<ULevel>, FLevelEntry> &Pair : Levels)
+    {
+        FLevelEntry &Entry = Pair.Value;
+        if (Entry.bAcquired && bReleaseLoaded)
+        {
+            Release(Entry);
+        }
+        else if (Entry.bAcquired)
+        {
+            Entry.bAcquired = false;
+            Entry.LoadedEvents.Reset();
+            Entry.PendingEvents.Reset();
+        }
+    }
+}
+
+void FFMODLevelPreloader::HandlePostWorldInitialization(UWorld *World, const UWorld::InitializationValues IVS)
+{
+    // The persistent level doesn't go through LevelAddedToWorld
+    if (World && World->PersistentLevel)
+    {
+        AddLevel(World->PersistentLevel, World);
+    }
+}
+
+void FFMODLevelPreloader::HandleWorldCleanup(UWorld *World, bool bSessionEnded, bool bCleanupResources)
+{
+    TArray<TObjectKey<ULevel>> WorldLevels;
+    for (const TPair<TObjectKey<ULevel>, FLevelEntry> &Pair : Levels)
+    {
+        if (Pair.Value.World == World || !Pair.Value.World.IsValid())
+        {
+            WorldLevels.Add(Pair.Key);
+        }
+    }
+
+    for (const TObjectKey<ULevel> &Level : WorldLevels)
+    {
+        RemoveLevel(Level);
+    }
+}
+
+void FFMODLevelPreloader::HandleLevelAdded(ULevel *Level, UWorld *World)
+{
+    AddLevel(Level, World);
+}
+
+void FFMODLevelPreloader::HandleLevelRemoved(ULevel *Level, UWorld *World)
+{
+    if (Level)
+    {
+        RemoveLevel(Level);
+    }
+    else
+    {
+        // A null level means every level of the world was removed
+        HandleWorldCleanup(World, false, false);
+    }
+}
+
+void FFMODLevelPreloader::AddLevel(ULevel *Level, UWorld *World)
+{
+    if (!Level || !World || !World->IsGameWorld() || Levels.Contains(Level) || !GetDefault<UFMODSettings>()->bPreloadLevelBanks)
+    {
+        return;
+    }
+
+    UFMODLevelBankManifest *Manifest = Level->GetAssetUserData<UFMODLevelBankManifest>();
+    if (!Manifest)
+    {
+        return;
+    }
+
+    FLevelEntry &Entry = Levels.Add(Level);
+    Entry.World = World;
+    Entry.bAcquired = false;
+
+    for (const FSoftObjectPath &Path : Manifest->Banks)
+    {
+        if (UFMODBank *Bank = Cast<UFMODBank>(IFMODStudioModule::Get().FindAssetByPath(Path)))
+        {
+            Entry.Banks.Add(Bank);
+        }
+    }
+
+    for (const FSoftObjectPath &Path : Manifest->Events)
+    {
+        if (UFMODEvent *Event = Cast<UFMODEvent>(IFMODStudioModule::Get().FindAssetByPath(Path)))
+        {
+            Entry.Events.Add(Event);
+        }
+    }
+
+    UE_LOG(LogFMOD, Verbose, TEXT("Preloading %d banks and %d events for level %s"), Entry.Banks.Num(), Entry.Events.Num(),
+        *Level->GetOutermost()->GetName());
+
+    if (IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime))
+    {
+        Acquire(Entry);
+    }
+}
+
+void FFMODLevelPreloader::RemoveLevel(const TObjectKey<ULevel> &Level)
+{
+    FLevelEntry Entry;
+    if (Levels.RemoveAndCopyValue(Level, Entry) && Entry.bAcquired)
+    {
+        Release(Entry);
+    }
+}
+
+void FFMODLevelPreloader::Acquire(FLevelEntry &Entry)
+{
+    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
+
+    for (const TWeakObjectPtr<UFMODBank> &Bank : Entry.Banks)
+    {
+        FFMODBankManager::Get().Acquire(StudioSystem, Bank.Get(), false);
+    }
+
+    // Sample data is requested from Update once the banks above have loaded
+    Entry.PendingEvents = Entry.Events;
+    Entry.bAcquired = true;
+}
+
+void FFMODLevelPreloader::Release(FLevelEntry &Entry)
+{
+    for (FMOD::Studio::EventDescription *EventDesc : Entry.LoadedEvents)
+    {
+        if (EventDesc->isValid())
+        {
+            verifyfmod(EventDesc->unloadSampleData());
+        }
+    }
+    Entry.LoadedEvents.Reset();
+    Entry.PendingEvents.Reset();
+
+    for (const TWeakObjectPtr<UFMODBank> &Bank : Entry.Banks)
+    {
+        FFMODBankManager::Get().Release(Bank.Get(), false);
+    }
+
+    Entry.bAcquired = false;
+}
@@ -0,0 +1,70 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "UObject/ObjectKey.h"
+
+namespace FMOD
+{
+namespace Studio
+{
+class EventDescription;
+}
+}
+
+class UFMODBank;
+class UFMODEvent;
+
+/**
+ * Loads the banks and event sample data listed in a level's FMOD manifest when the level is added to a game world,
+ * and releases them when it is removed.  Banks are shared through the bank manager so levels that overlap keep them
+ * loaded.  Game thread only.
+ */
+class FFMODLevelPreloader
+{
+public:
+    static FFMODLevelPreloader &Get();
+
+    /** Start listening for levels being added to and removed from worlds */
+    void Startup();
+    void Shutdown();
+
+    /** Acquire levels that were added before the runtime system existed, and load sample data for events whose banks have finished loading */
+    void Update();
+
+    /**
+     * Forget what was acquired, called when the runtime system is about to be released along with its banks.
+     * Pass bReleaseLoaded when the system is kept instead, so that sample data loaded for levels is unloaded first.
+     */
+    void Reset(bool bReleaseLoaded);
+
+private:
+    struct FLevelEntry
+    {
+        TWeakObjectPtr<UWorld> World;
+        TArray<TWeakObjectPtr<UFMODBank>> Banks;
+        TArray<TWeakObjectPtr<UFMODEvent>> Events;
+        TArray<TWeakObjectPtr<UFMODEvent>> PendingEvents;
+        TArray<FMOD::Studio::EventDescription *> LoadedEvents;
+        bool bAcquired;
+    };
+
+    void HandlePostWorldInitialization(UWorld *World, const UWorld::InitializationValues IVS);
+    void HandleWorldCleanup(UWorld *World, bool bSessionEnded, bool bCleanupResources);
+    void HandleLevelAdded(ULevel *Level, UWorld *World);
+    void HandleLevelRemoved(ULevel *Level, UWorld *World);
+
+    void AddLevel(ULevel *Level, UWorld *World);
+    void RemoveLevel(const TObjectKey<ULevel> &Level);
+    void Acquire(FLevelEntry &Entry);
+    void Release(FLevelEntry &Entry);
+
+    TMap<TObjectKey<ULevel>, FLevelEntry> Levels;
+
+    FDelegateHandle PostWorldInitializationHandle;
+    FDelegateHandle WorldCleanupHandle;
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle LevelRemovedHandle;
+};
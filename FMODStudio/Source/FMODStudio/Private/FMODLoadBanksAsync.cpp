@@ -0,0 +1,54 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODLoadBanksAsync.h"
+#include "FMODBank.h"
+#include "FMODStudioModule.h"
+#include "FMODStudioPrivatePCH.h"
+
+UFMODLoadBanksAsync::UFMODLoadBanksAsync(const FObjectInitializer &ObjectInitializer)
+    : Super(ObjectInitializer)
+    , bLoadSampleData(false)
+{
+}
+
+UFMODLoadBanksAsync *UFMODLoadBanksAsync::LoadBanksAsync(UObject *WorldContextObject, const TArray<UFMODBank *> &Banks, bool bLoadSampleData)
+{
+    UFMODLoadBanksAsync *Action = NewObject<UFMODLoadBanksAsync>();
+    Action->Banks = Banks;
+    Action->bLoadSampleData = bLoadSampleData;
+    Action->RegisterWithGameInstance(WorldContextObject);
+    return Action;
+}
+
+void UFMODLoadBanksAsync::Activate()
+{
+    if (!IFMODStudioModule::IsAvailable())
+    {
+        HandleCompleted(false);
+        return;
+    }
+
+    Request = IFMODStudioModule::Get().LoadBanksAsync(Banks, bLoadSampleData);
+    Request->OnProgress.AddUObject(this, &UFMODLoadBanksAsync::HandleProgress);
+    Request->OnCompleted.AddUObject(this, &UFMODLoadBanksAsync::HandleCompleted);
+}
+
+void UFMODLoadBanksAsync::HandleProgress(float Progress)
+{
+    OnProgress.Broadcast(Progress);
+}
+
+void UFMODLoadBanksAsync::HandleCompleted(bool bSucceeded)
+{
+    if (bSucceeded)
+    {
+        Completed.Broadcast();
+    }
+    else
+    {
+        Failed.Broadcast();
+    }
+
+    Request.Reset();
+    SetReadyToDestroy();
+}
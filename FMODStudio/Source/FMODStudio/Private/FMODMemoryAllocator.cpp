@@ -0,0 +1,378 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODMemoryAllocator.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/ScopeLock.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+namespace
+{
+// FMOD expects 16 byte aligned memory, so every block starts with a header of that size
+const uint32 FMODAlignment = 16;
+
+// Each size class grows a page at a time
+const uint32 PageSize = 64 * 1024;
+
+// Block sizes including the header.  Most of FMOD's allocations are small, long lived objects
+const uint32 BlockSizes[] = { 32, 48, 64, 80, 96, 128, 160, 192, 256, 320, 384, 512, 768, 1024, 1536, 2048, 3072, 4096 };
+
+// Marks a block that came straight from the engine allocator
+const uint16 LargeClass = 0xffff;
+
+// Free list heads hold a block address in the low bits, without its alignment bits since blocks are 16 byte aligned, and a
+// tag in the rest.  The tag changes with every update, so a pop that read a block which another thread popped and pushed
+// back in the meantime fails its exchange instead of installing a stale next pointer.
+const uint32 FreeHeadAddressBits = 48;
+const uint32 FreeHeadPointerBits = FreeHeadAddressBits - 4;
+const uint64 FreeHeadPointerMask = (1ull << FreeHeadPointerBits) - 1;
+
+int64 PackFreeHead(const void *Block, int64 PreviousHead)
+{
+    const uint64 Tag = ((uint64)PreviousHead >> FreeHeadPointerBits) + 1;
+    return (int64)((Tag << FreeHeadPointerBits) | ((UPTRINT)Block >> 4));
+}
+
+template <typename T> T *UnpackFreeHead(int64 Head)
+{
+    return (T *)(UPTRINT)(((uint64)Head & FreeHeadPointerMask) << 4);
+}
+}
+
+struct FFMODMemoryAllocator::FHeader
+{
+    uint32 Size;
+    uint16 ClassIndex;
+    uint16 Type;
+    uint8 Padding[FMODAlignment - sizeof(uint32) - 2 * sizeof(uint16)];
+};
+
+struct FFMODMemoryAllocator::FFreeBlock
+{
+    FFreeBlock *Next;
+};
+
+FFMODMemoryAllocator::FFMODMemoryAllocator()
+    : bUsePools(false)
+    , PooledAllocations(0)
+    , PoolReservedBytes(0)
+{
+    static_assert(sizeof(FHeader) == FMODAlignment, "FMOD memory header must keep blocks aligned");
+    static_assert(UE_ARRAY_COUNT(BlockSizes) == NumSizeClasses, "Size class count doesn't match the block sizes");
+
+    for (int32 i = 0; i < Type_Max; ++i)
+    {
+        CurrentBytes[i] = 0;
+        PeakBytes[i] = 0;
+    }
+    for (int32 i = 0; i < NumSizeClasses; ++i)
+    {
+        SizeClasses[i].FreeHead = 0;
+        SizeClasses[i].BlockSize = BlockSizes[i];
+    }
+}
+
+FFMODMemoryAllocator &FFMODMemoryAllocator::Get()
+{
+    static FFMODMemoryAllocator Instance;
+    return Instance;
+}
+
+void FFMODMemoryAllocator::Initialize(bool bInUsePools)
+{
+    bUsePools = bInUsePools;
+}
+
+void FFMODMemoryAllocator::Shutdown()
+{
+    for (int32 i = 0; i < Type_Max; ++i)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("FMOD memory type %d peaked at %lld bytes"), i, PeakBytes[i]);
+    }
+
+    if (PooledAllocations != 0)
+    {
+        // Something is still pointing into the pages, leave them for the process to clean up
+        UE_LOG(LogFMOD, Warning, TEXT("%lld FMOD allocations are still outstanding, keeping memory pools"), PooledAllocations);
+        return;
+    }
+
+    // Empty the free lists before the pages they point into go away
+    for (FSizeClass &SizeClass : SizeClasses)
+    {
+        SizeClass.FreeHead = 0;
+    }
+
+    FScopeLock Lock(&PagesCrit);
+    for (void *Page : Pages)
+    {
+        FMemory::Free(Page);
+    }
+    Pages.Reset();
+    PoolReservedBytes = 0;
+}
+
+void *F_CALLBACK FFMODMemoryAllocator::Alloc(unsigned int Size, FMOD_MEMORY_TYPE Type, const char *SourceStr)
+{
+    return Get().Allocate(Size, Type);
+}
+
+void *F_CALLBACK FFMODMemoryAllocator::Realloc(void *Ptr, unsigned int Size, FMOD_MEMORY_TYPE Type, const char *SourceStr)
+{
+    return Get().Reallocate(Ptr, Size, Type);
+}
+
+void F_CALLBACK FFMODMemoryAllocator::Free(void *Ptr, FMOD_MEMORY_TYPE Type, const char *SourceStr)
+{
+    Get().Deallocate(Ptr);
+}
+
+void *FFMODMemoryAllocator::Allocate(unsigned int Size, FMOD_MEMORY_TYPE FMODType)
+{
+    const EType Type = GetType(FMODType);
+    const int32 ClassIndex = GetSizeClass(Size + sizeof(FHeader), FMODType);
+
+    FHeader *Header = nullptr;
+    if (ClassIndex != INDEX_NONE)
+    {
+        FSizeClass &SizeClass = SizeClasses[ClassIndex];
+        Header = (FHeader *)PopFree(SizeClass);
+        while (!Header && GrowPool(ClassIndex))
+        {
+            Header = (FHeader *)PopFree(SizeClass);
+        }
+
+        if (Header)
+        {
+            FPlatformAtomics::InterlockedIncrement(&PooledAllocations);
+        }
+    }
+
+    uint16 HeaderClass = (uint16)ClassIndex;
+    if (!Header)
+    {
+        // Too big for the pools, or no page could be added to them
+        LLM_SCOPE(ELLMTag::Audio);
+        Header = (FHeader *)FMemory::Malloc(Size + sizeof(FHeader), FMODAlignment);
+        HeaderClass = LargeClass;
+    }
+
+    if (!Header)
+    {
+        return nullptr;
+    }
+
+    Header->Size = Size;
+    Header->ClassIndex = HeaderClass;
+    Header->Type = (uint16)Type;
+    AddBytes(Type, Size);
+
+    return Header + 1;
+}
+
+void *FFMODMemoryAllocator::Reallocate(void *Ptr, unsigned int Size, FMOD_MEMORY_TYPE FMODType)
+{
+    if (!Ptr)
+    {
+        return Allocate(Size, FMODType);
+    }
+
+    FHeader *Header = (FHeader *)Ptr - 1;
+    const EType Type = (EType)Header->Type;
+
+    if (Header->ClassIndex == LargeClass)
+    {
+        if (GetSizeClass(Size + sizeof(FHeader), FMODType) == INDEX_NONE)
+        {
+            const int64 OldSize = Header->Size;
+            LLM_SCOPE(ELLMTag::Audio);
+            FHeader *NewHeader = (FHeader *)FMemory::Realloc(Header, Size + sizeof(FHeader), FMODAlignment);
+            if (!NewHeader)
+            {
+                return nullptr;
+            }
+            NewHeader->Size = Size;
+            AddBytes(Type, (int64)Size - OldSize);
+            return NewHeader + 1;
+        }
+    }
+    else if (Size + sizeof(FHeader) <= SizeClasses[Header->ClassIndex].BlockSize)
+    {
+        // Still fits in the same block
+        AddBytes(Type, (int64)Size - Header->Size);
+        Header->Size = Size;
+        return Ptr;
+    }
+
+    void *NewPtr = Allocate(Size, FMODType);
+    if (NewPtr)
+    {
+        FMemory::Memcpy(NewPtr, Ptr, FMath::Min<uint32>(Size, Header->Size));
+        Deallocate(Ptr);
+    }
+    return NewPtr;
+}
+
+void FFMODMemoryAllocator::Deallocate(void *Ptr)
+{
+    if (!Ptr)
+    {
+        return;
+    }
+
+    FHeader *Header = (FHeader *)Ptr - 1;
+    AddBytes((EType)Header->Type, -(int64)Header->Size);
+
+    if (Header->ClassIndex == LargeClass)
+    {
+        FMemory::Free(Header);
+    }
+    else
+    {
+        FPlatformAtomics::InterlockedDecrement(&PooledAllocations);
+        FFreeBlock *Block = (FFreeBlock *)Header;
+        PushFree(SizeClasses[Header->ClassIndex], Block, Block);
+    }
+}
+
+bool FFMODMemoryAllocator::GrowPool(int32 ClassIndex)
+{
+    FSizeClass &SizeClass = SizeClasses[ClassIndex];
+
+    void *Page = nullptr;
+    {
+        LLM_SCOPE(ELLMTag::Audio);
+        Page = FMemory::Malloc(PageSize, FMODAlignment);
+    }
+    if (!Page)
+    {
+        return false;
+    }
+
+    if (((UPTRINT)Page + PageSize) >> FreeHeadAddressBits)
+    {
+        // The free lists can't hold addresses this high, so leave this size class to the engine allocator
+        FMemory::Free(Page);
+        return false;
+    }
+
+    {
+        FScopeLock Lock(&PagesCrit);
+        Pages.Add(Page);
+    }
+    FPlatformAtomics::InterlockedAdd(&PoolReservedBytes, (int64)PageSize);
+
+    // Link the blocks up before publishing them all at once.  Other threads may grow the same class at the same time,
+    // which just leaves a few more free blocks.
+    const uint32 NumBlocks = PageSize / SizeClass.BlockSize;
+    FFreeBlock *First = (FFreeBlock *)Page;
+    FFreeBlock *Last = (FFreeBlock *)((uint8 *)Page + (NumBlocks - 1) * SizeClass.BlockSize);
+    for (uint32 i = 0; i + 1 < NumBlocks; ++i)
+    {
+        FFreeBlock *Block = (FFreeBlock *)((uint8 *)Page + i * SizeClass.BlockSize);
+        Block->Next = (FFreeBlock *)((uint8 *)Block + SizeClass.BlockSize);
+    }
+
+    PushFree(SizeClass, First, Last);
+    return true;
+}
+
+void FFMODMemoryAllocator::PushFree(FSizeClass &SizeClass, FFreeBlock *First, FFreeBlock *Last)
+{
+    int64 Head = SizeClass.FreeHead;
+    while (true)
+    {
+        Last->Next = UnpackFreeHead<FFreeBlock>(Head);
+        const int64 Previous = FPlatformAtomics::InterlockedCompareExchange(&SizeClass.FreeHead, PackFreeHead(First, Head), Head);
+        if (Previous == Head)
+        {
+            return;
+        }
+        Head = Previous;
+    }
+}
+
+FFMODMemoryAllocator::FFreeBlock *FFMODMemoryAllocator::PopFree(FSizeClass &SizeClass)
+{
+    int64 Head = SizeClass.FreeHead;
+    while (true)
+    {
+        FFreeBlock *Block = UnpackFreeHead<FFreeBlock>(Head);
+        if (!Block)
+        {
+            return nullptr;
+        }
+
+        // If another thread takes the block first this reads whatever FMOD wrote into it, which is harmless because the
+        // page stays mapped and the changed tag makes the exchange fail
+        const int64 Previous = FPlatformAtomics::InterlockedCompareExchange(&SizeClass.FreeHead, PackFreeHead(Block->Next, Head), Head);
+        if (Previous == Head)
+        {
+            return Block;
+        }
+        Head = Previous;
+    }
+}
+
+void FFMODMemoryAllocator::AddBytes(EType Type, int64 Bytes)
+{
+    const int64 Current = FPlatformAtomics::InterlockedAdd(&CurrentBytes[Type], Bytes) + Bytes;
+
+    int64 Peak = PeakBytes[Type];
+    while (Current > Peak)
+    {
+        const int64 Previous = FPlatformAtomics::InterlockedCompareExchange(&PeakBytes[Type], Current, Peak);
+        if (Previous == Peak)
+        {
+            break;
+        }
+        Peak = Previous;
+    }
+}
+
+FFMODMemoryAllocator::EType FFMODMemoryAllocator::GetType(FMOD_MEMORY_TYPE FMODType)
+{
+    if (FMODType & FMOD_MEMORY_STREAM_FILE)
+    {
+        return Type_StreamFile;
+    }
+    if (FMODType & FMOD_MEMORY_STREAM_DECODE)
+    {
+        return Type_StreamDecode;
+    }
+    if (FMODType & FMOD_MEMORY_SAMPLEDATA)
+    {
+        return Type_SampleData;
+    }
+    if (FMODType & FMOD_MEMORY_DSP_BUFFER)
+    {
+        return Type_DSPBuffer;
+    }
+    if (FMODType & FMOD_MEMORY_PLUGIN)
+    {
+        return Type_Plugin;
+    }
+    if (FMODType & FMOD_MEMORY_PERSISTENT)
+    {
+        return Type_Persistent;
+    }
+    return Type_Normal;
+}
+
+int32 FFMODMemoryAllocator::GetSizeClass(uint32 BlockSize, FMOD_MEMORY_TYPE FMODType) const
+{
+    // Sample data and stream buffers are large and come and go with banks and streams, keep them out of the pools
+    if (!bUsePools || (FMODType & (FMOD_MEMORY_STREAM_FILE | FMOD_MEMORY_STREAM_DECODE | FMOD_MEMORY_SAMPLEDATA)))
+    {
+        return INDEX_NONE;
+    }
+
+    for (int32 i = 0; i < NumSizeClasses; ++i)
+    {
+        if (BlockSize <= SizeClasses[i].BlockSize)
+        {
+            return i;
+        }
+    }
+    return INDEX_NONE;
+}
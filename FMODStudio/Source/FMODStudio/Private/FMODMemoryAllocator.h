@@ -0,0 +1,92 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "fmod_common.h"
+
+/**
+ * Memory callbacks handed to FMOD::Memory_Initialize.  Every allocation is tagged under LLM and counted per FMOD memory type.
+ * When pooling is enabled, small allocations come from size class pools with pages that are kept for the lifetime of the
+ * module, while sample data, stream buffers and anything larger than the biggest size class go straight to the engine
+ * allocator.  Free blocks are linked through their own memory into a lock-free list per size class.  Safe to call from
+ * any thread.
+ */
+class FFMODMemoryAllocator
+{
+public:
+    /** The FMOD memory types that are tracked separately */
+    enum EType
+    {
+        Type_Normal,
+        Type_StreamFile,
+        Type_StreamDecode,
+        Type_SampleData,
+        Type_DSPBuffer,
+        Type_Plugin,
+        Type_Persistent,
+        Type_Max
+    };
+
+    FFMODMemoryAllocator();
+
+    static FFMODMemoryAllocator &Get();
+
+    /** Must be called before FMOD::Memory_Initialize, and before any allocation is made */
+    void Initialize(bool bInUsePools);
+
+    /** Release the pool pages, if FMOD has freed everything allocated from them */
+    void Shutdown();
+
+    static void *F_CALLBACK Alloc(unsigned int Size, FMOD_MEMORY_TYPE Type, const char *SourceStr);
+    static void *F_CALLBACK Realloc(void *Ptr, unsigned int Size, FMOD_MEMORY_TYPE Type, const char *SourceStr);
+    static void F_CALLBACK Free(void *Ptr, FMOD_MEMORY_TYPE Type, const char *SourceStr);
+
+    /** Bytes currently allocated by FMOD for a memory type, and the most there has been at once */
+    int64 GetCurrentBytes(EType Type) const { return CurrentBytes[Type]; }
+    int64 GetPeakBytes(EType Type) const { return PeakBytes[Type]; }
+
+    /** Bytes of pool pages reserved from the engine allocator */
+    int64 GetPoolReservedBytes() const { return PoolReservedBytes; }
+
+private:
+    struct FHeader;
+    struct FFreeBlock;
+
+    static const int32 NumSizeClasses = 18;
+
+    // Each class gets its own cache line, so threads allocating different sizes don't contend
+    MS_ALIGN(PLATFORM_CACHE_LINE_SIZE) struct FSizeClass
+    {
+        /** First free block, packed with a tag that changes on every push and pop, see PackFreeHead */
+        volatile int64 FreeHead;
+        uint32 BlockSize;
+    } GCC_ALIGN(PLATFORM_CACHE_LINE_SIZE);
+
+    void *Allocate(unsigned int Size, FMOD_MEMORY_TYPE FMODType);
+    void *Reallocate(void *Ptr, unsigned int Size, FMOD_MEMORY_TYPE FMODType);
+    void Deallocate(void *Ptr);
+
+    /** Carve a new page into blocks for a size class, returns false if the page could not be allocated */
+    bool GrowPool(int32 ClassIndex);
+
+    /** Push a chain of blocks already linked from First to Last onto a size class's free list */
+    static void PushFree(FSizeClass &SizeClass, FFreeBlock *First, FFreeBlock *Last);
+    static FFreeBlock *PopFree(FSizeClass &SizeClass);
+
+    void AddBytes(EType Type, int64 Bytes);
+
+    static EType GetType(FMOD_MEMORY_TYPE FMODType);
+    int32 GetSizeClass(uint32 BlockSize, FMOD_MEMORY_TYPE FMODType) const;
+
+    bool bUsePools;
+    FSizeClass SizeClasses[NumSizeClasses];
+
+    FCriticalSection PagesCrit;
+    TArray<void *> Pages;
+
+    volatile int64 CurrentBytes[Type_Max];
+    volatile int64 PeakBytes[Type_Max];
+    volatile int64 PooledAllocations;
+    volatile int64 PoolReservedBytes;
+};
@@ -0,0 +1,200 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODOcclusionManager.h"
+#include "FMODAudioComponent.h"
+#include "FMODCommandBuffer.h"
+#include "FMODListener.h"
+#include "FMODSettings.h"
+#include "FMODStudioModule.h"
+#include "fmod_studio.hpp"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "FMODStudioPrivatePCH.h"
+
+FFMODOcclusionManager::FFMODOcclusionManager()
+    : NextEmitterId(0)
+{
+    TraceDelegate.BindRaw(this, &FFMODOcclusionManager::OnTraceCompleted);
+}
+
+FFMODOcclusionManager &FFMODOcclusionManager::Get()
+{
+    static FFMODOcclusionManager Instance;
+    return Instance;
+}
+
+void FFMODOcclusionManager::Register(UFMODAudioComponent *Component)
+{
+    if (EmitterIds.Contains(Component))
+    {
+        return;
+    }
+
+    // Ids are never reused, so results for an emitter that has since been removed are simply dropped
+    const uint32 EmitterId = ++NextEmitterId;
+    FEmitter &Emitter = Emitters.Add(EmitterId);
+    Emitter.Component = Component;
+    Emitter.World = Component->GetWorld();
+    Emitter.Staleness = 0.0f;
+    Emitter.PendingRays = 0;
+    Emitter.BlockedRays = 0;
+    Emitter.TracedRays = 0;
+    EmitterIds.Add(Component, EmitterId);
+}
+
+void FFMODOcclusionManager::Update(float DeltaTime)
+{
+    if (Emitters.Num() == 0)
+    {
+        return;
+    }
+
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    IFMODStudioModule &Module = IFMODStudioModule::Get();
+
+    for (TPair<UWorld *, TArray<FCandidate>> &Pair : WorldCandidates)
+    {
+        Pair.Value.Reset();
+    }
+
+    for (TMap<uint32, FEmitter>::TIterator It(Emitters); It; ++It)
+    {
+        FEmitter &Emitter = It.Value();
+        UFMODAudioComponent *Component = Emitter.Component.Get();
+        UWorld *World = Emitter.World.Get();
+        if (Component == nullptr || World == nullptr || Component->StudioInstance == nullptr || !Component->bApplyOcclusionParameter ||
+            !Component->OcclusionDetails.bEnableOcclusion || Component->GetOwner() == nullptr)
+        {
+            EmitterIds.Remove(Emitter.Component);
+            It.RemoveCurrent();
+            continue;
+        }
+
+        // Ease towards the latest traced value
+        if (Component->OcclusionCurrent >= 0.0f && Component->OcclusionCurrent != Component->OcclusionTarget)
+        {
+            Component->OcclusionCurrent = Settings.OcclusionSmoothingTime > 0.0f ?
+                FMath::FInterpConstantTo(Component->OcclusionCurrent, Component->OcclusionTarget, DeltaTime, 1.0f / Settings.OcclusionSmoothingTime) :
+                Component->OcclusionTarget;
+            FFMODCommandBuffer::Get().SetParameterByID(Component->StudioInstance, Component->OcclusionID, Component->OcclusionCurrent);
+        }
+
+        if (Emitter.PendingRays > 0)
+        {
+            continue;
+        }
+
+        Emitter.Staleness += DeltaTime;
+
+        const FVector Location = Component->GetOwner()->GetActorLocation();
+        const float Distance = FVector::Dist(Location, Module.GetNearestListener(Location).Transform.GetLocation());
+
+        FCandidate Candidate;
+        Candidate.EmitterId = It.Key();
+        Candidate.Score = Emitter.Staleness * FMath::Max(Component->OcclusionDetails.OcclusionPriority, KINDA_SMALL_NUMBER) /
+                          FMath::Max(Distance, 100.0f);
+        WorldCandidates.FindOrAdd(World).Add(Candidate);
+    }
+
+    for (TMap<UWorld *, TArray<FCandidate>>::TIterator It(WorldCandidates); It; ++It)
+    {
+        TArray<FCandidate> &Candidates = It.Value();
+        if (Candidates.Num() == 0)
+        {
+            // World has no emitters left, which may mean it has gone away
+            It.RemoveCurrent();
+            continue;
+        }
+
+        Candidates.Sort([](const FCandidate &A, const FCandidate &B) { return A.Score > B.Score; });
+
+        int32 RaysIssued = 0;
+        for (const FCandidate &Candidate : Candidates)
+        {
+            const FEmitter &Emitter = Emitters[Candidate.EmitterId];
+            const int32 RayCount = Emitter.Component->OcclusionDetails.OcclusionRayCount;
+
+            // Always trace at least one emitter per frame so that a small budget can't starve everything
+            if (RaysIssued > 0 && RaysIssued + RayCount > Settings.OcclusionTraceBudget)
+            {
+                break;
+            }
+            IssueTraces(It.Key(), Candidate.EmitterId);
+            RaysIssued += RayCount;
+        }
+    }
+}
+
+void FFMODOcclusionManager::IssueTraces(UWorld *World, uint32 EmitterId)
+{
+    static FName NAME_SoundOcclusion = FName(TEXT("SoundOcclusion"));
+
+    FEmitter &Emitter = Emitters[EmitterId];
+    UFMODAudioComponent *Component = Emitter.Component.Get();
+    const FFMODOcclusionDetails &Details = Component->OcclusionDetails;
+
+    FCollisionQueryParams Params(NAME_SoundOcclusion, Details.bUseComplexCollisionForOcclusion, Component->GetOwner());
+
+    const FVector Location = Component->GetOwner()->GetActorLocation();
+    const FVector ListenerLocation = IFMODStudioModule::Get().GetNearestListener(Location).Transform.GetLocation();
+
+    // Extra rays start on a ring around the emitter, facing the listener
+    FVector Right, Up;
+    (ListenerLocation - Location).GetSafeNormal().FindBestAxisVectors(Right, Up);
+
+    const int32 RayCount = FMath::Max(Details.OcclusionRayCount, 1);
+    for (int32 RayIdx = 0; RayIdx < RayCount; ++RayIdx)
+    {
+        FVector Start = Location;
+        if (RayIdx > 0)
+        {
+            float Sin, Cos;
+            FMath::SinCos(&Sin, &Cos, 2.0f * PI * (RayIdx - 1) / (RayCount - 1));
+            Start += (Right * Cos + Up * Sin) * Details.OcclusionRayRadius;
+        }
+        World->AsyncLineTraceByChannel(EAsyncTraceType::Test, Start, ListenerLocation, Details.OcclusionTraceChannel, Params,
+            FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, EmitterId);
+    }
+
+    Emitter.Staleness = 0.0f;
+    Emitter.PendingRays = RayCount;
+    Emitter.BlockedRays = 0;
+    Emitter.TracedRays = RayCount;
+}
+
+void FFMODOcclusionManager::OnTraceCompleted(const FTraceHandle &Handle, FTraceDatum &Datum)
+{
+    FEmitter *Emitter = Emitters.Find(Datum.UserData);
+    if (Emitter == nullptr || Emitter->PendingRays == 0)
+    {
+        return;
+    }
+
+    if (FHitResult::GetFirstBlockingHit(Datum.OutHits) != nullptr)
+    {
+        ++Emitter->BlockedRays;
+    }
+
+    if (--Emitter->PendingRays == 0)
+    {
+        UFMODAudioComponent *Component = Emitter->Component.Get();
+        if (Component && Component->StudioInstance)
+        {
+            Component->OcclusionTarget = (float)Emitter->BlockedRays / Emitter->TracedRays;
+
+            // The first result for a new instance is applied straight away
+            if (Component->OcclusionCurrent < 0.0f)
+            {
+                Component->OcclusionCurrent = Component->OcclusionTarget;
+                FFMODCommandBuffer::Get().SetParameterByID(Component->StudioInstance, Component->OcclusionID, Component->OcclusionCurrent);
+            }
+        }
+    }
+}
+
+void FFMODOcclusionManager::Reset()
+{
+    Emitters.Reset();
+    EmitterIds.Reset();
+    WorldCandidates.Reset();
+}
@@ -0,0 +1,61 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "WorldCollision.h"
+
+class UFMODAudioComponent;
+class UWorld;
+
+/**
+ * Runs occlusion checks for FMOD audio components as asynchronous line traces, a limited number of rays per world
+ * each frame.  Emitters are picked by how long they have waited, their priority and their distance to the nearest
+ * listener.  Each emitter can cast several rays, giving an occlusion amount from 0 to 1 which is smoothed before
+ * being sent to the event's occlusion parameter.  Must only be used from the game thread.
+ */
+class FFMODOcclusionManager
+{
+public:
+    static FFMODOcclusionManager &Get();
+
+    /** Start checking occlusion for a component, if it isn't already */
+    void Register(UFMODAudioComponent *Component);
+
+    /** Apply smoothed results and issue this frame's traces.  Called once per frame. */
+    void Update(float DeltaTime);
+
+    /** Forget every emitter.  Traces still in flight are ignored when they complete. */
+    void Reset();
+
+private:
+    FFMODOcclusionManager();
+
+    void IssueTraces(UWorld *World, uint32 EmitterId);
+    void OnTraceCompleted(const FTraceHandle &Handle, FTraceDatum &Datum);
+
+    struct FEmitter
+    {
+        TWeakObjectPtr<UFMODAudioComponent> Component;
+        TWeakObjectPtr<UWorld> World;
+        float Staleness;
+        int32 PendingRays;
+        int32 BlockedRays;
+        int32 TracedRays;
+    };
+
+    struct FCandidate
+    {
+        uint32 EmitterId;
+        float Score;
+    };
+
+    TMap<uint32, FEmitter> Emitters;
+    TMap<TWeakObjectPtr<UFMODAudioComponent>, uint32> EmitterIds;
+    uint32 NextEmitterId;
+    FTraceDelegate TraceDelegate;
+
+    // Scratch space reused between updates
+    TMap<UWorld *, TArray<FCandidate>> WorldCandidates;
+};
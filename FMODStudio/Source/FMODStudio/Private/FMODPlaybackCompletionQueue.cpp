@@ -0,0 +1,97 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODPlaybackCompletionQueue.h"
+#include "FMODAudioComponent.h"
+#include "fmod_studio.hpp"
+#include "FMODStudioPrivatePCH.h"
+
+FFMODPlaybackCompletionQueue &FFMODPlaybackCompletionQueue::Get()
+{
+    static FFMODPlaybackCompletionQueue Instance;
+    return Instance;
+}
+
+void FFMODPlaybackCompletionQueue::Track(UFMODAudioComponent *Component, FMOD::Studio::EventInstance *Instance)
+{
+    Tracked.Add(Instance, Component);
+}
+
+void FFMODPlaybackCompletionQueue::Untrack(FMOD::Studio::EventInstance *Instance)
+{
+    Tracked.Remove(Instance);
+}
+
+void FFMODPlaybackCompletionQueue::Post(FMOD::Studio::EventInstance *Instance)
+{
+    Stopped.Enqueue(Instance);
+}
+
+void FFMODPlaybackCompletionQueue::Update()
+{
+    for (const TWeakObjectPtr<UFMODAudioComponent> &WeakComponent : Orphaned)
+    {
+        UFMODAudioComponent *Component = WeakComponent.Get();
+        if (Component && Component->IsActive())
+        {
+            if (Component->StudioInstance && Component->StudioInstance->isValid())
+            {
+                // Belongs to a Studio system that is still around
+                Tracked.Add(Component->StudioInstance, WeakComponent);
+            }
+            else
+            {
+                Component->OnPlaybackCompleted();
+            }
+        }
+    }
+    Orphaned.Reset();
+
+    FMOD::Studio::EventInstance *Instance = nullptr;
+    while (Stopped.Dequeue(Instance))
+    {
+        TWeakObjectPtr<UFMODAudioComponent> WeakComponent;
+        if (!Tracked.RemoveAndCopyValue(Instance, WeakComponent))
+        {
+            continue;
+        }
+
+        UFMODAudioComponent *Component = WeakComponent.Get();
+        if (Component == nullptr || !Component->IsActive() || Component->StudioInstance != Instance)
+        {
+            continue;
+        }
+
+        // The instance may have been started again since the callback was posted
+        FMOD_STUDIO_PLAYBACK_STATE State = FMOD_STUDIO_PLAYBACK_STOPPED;
+        if (Instance->getPlaybackState(&State) == FMOD_OK && State != FMOD_STUDIO_PLAYBACK_STOPPED)
+        {
+            Tracked.Add(Instance, WeakComponent);
+            continue;
+        }
+
+        Component->OnPlaybackCompleted();
+    }
+}
+
+void FFMODPlaybackCompletionQueue::Reset()
+{
+    for (const TPair<FMOD::Studio::EventInstance *, TWeakObjectPtr<UFMODAudioComponent>> &Pair : Tracked)
+    {
+        Orphaned.Add(Pair.Value);
+    }
+    Tracked.Reset();
+    Stopped.Empty();
+}
+
+void FFMODPlaybackCompletionQueue::OrphanInvalidInstances()
+{
+    // Stop notifications for other systems' instances stay queued
+    for (auto It = Tracked.CreateIterator(); It; ++It)
+    {
+        if (!It.Key()->isValid())
+        {
+            Orphaned.Add(It.Value());
+            It.RemoveCurrent();
+        }
+    }
+}
@@ -0,0 +1,53 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UFMODAudioComponent;
+
+namespace FMOD
+{
+namespace Studio
+{
+class EventInstance;
+}
+}
+
+/**
+ * Hands FMOD_STUDIO_EVENT_CALLBACK_STOPPED notifications from FMOD's threads to the game thread, so audio components
+ * don't have to poll their playback state every tick.  FMOD threads only post instance handles; they are matched
+ * back to their components when the queue is drained once per frame.
+ */
+class FFMODPlaybackCompletionQueue
+{
+public:
+    static FFMODPlaybackCompletionQueue &Get();
+
+    /** Associate an instance with the component playing it.  Game thread only. */
+    void Track(UFMODAudioComponent *Component, FMOD::Studio::EventInstance *Instance);
+
+    /** Forget an instance that is being released.  Game thread only. */
+    void Untrack(FMOD::Studio::EventInstance *Instance);
+
+    /** Report that an instance has stopped.  Safe to call from FMOD callbacks. */
+    void Post(FMOD::Studio::EventInstance *Instance);
+
+    /** Complete playback for every component whose instance stopped.  Called once per frame. */
+    void Update();
+
+    /** Complete every tracked component on the next update.  Called when the runtime system is going away. */
+    void Reset();
+
+    /** Complete the components whose instances are no longer valid on the next update, after another system was released */
+    void OrphanInvalidInstances();
+
+private:
+    TQueue<FMOD::Studio::EventInstance *, EQueueMode::Mpsc> Stopped;
+    TMap<FMOD::Studio::EventInstance *, TWeakObjectPtr<UFMODAudioComponent>> Tracked;
+
+    // Components whose instances went away with their Studio system
+    TArray<TWeakObjectPtr<UFMODAudioComponent>> Orphaned;
+};
@@ -0,0 +1,281 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODProgrammerSoundCache.h"
+#include "FMODSettings.h"
+#include "FMODStudioModule.h"
+#include "fmod_studio.hpp"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "FMODStudioPrivatePCH.h"
+
+FFMODProgrammerSoundCache::FFMODProgrammerSoundCache()
+    : TotalBytes(0)
+{
+}
+
+FFMODProgrammerSoundCache &FFMODProgrammerSoundCache::Get()
+{
+    static FFMODProgrammerSoundCache Instance;
+    return Instance;
+}
+
+FMOD::Sound *FFMODProgrammerSoundCache::Acquire(FMOD::Studio::System *StudioSystem, const FString &SoundName, int32 &OutSubsoundIndex)
+{
+    FScopeLock Lock(&Crit);
+
+    FMOD::System *CoreSystem = nullptr;
+    if (StudioSystem == nullptr || StudioSystem->getCoreSystem(&CoreSystem) != FMOD_OK)
+    {
+        return nullptr;
+    }
+
+    // Drop sounds that failed to load so that they get another try
+    UpdateLoading();
+
+    FEntry *Entry = FindOrCreate(StudioSystem, CoreSystem, SoundName);
+    if (Entry == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (Entry->bStream && Entry->RefCount > 0)
+    {
+        // A stream can't be shared between instruments, this one is released by the caller
+        bool bStream = false;
+        return CreateSound(StudioSystem, CoreSystem, SoundName, OutSubsoundIndex, bStream);
+    }
+
+    if (Entry->RefCount++ == 0 && Entry->UnusedNode)
+    {
+        Unused.RemoveNode(Entry->UnusedNode);
+        Entry->UnusedNode = nullptr;
+    }
+    OutSubsoundIndex = Entry->SubsoundIndex;
+    FMOD::Sound *Sound = Entry->Sound;
+
+    Trim();
+    return Sound;
+}
+
+bool FFMODProgrammerSoundCache::Release(FMOD::Sound *Sound)
+{
+    FScopeLock Lock(&Crit);
+
+    const FKey *Key = SoundKeys.Find(Sound);
+    if (Key == nullptr)
+    {
+        return false;
+    }
+
+    FEntry &Entry = Entries[*Key];
+    check(Entry.RefCount > 0);
+    if (--Entry.RefCount == 0)
+    {
+        Unused.AddTail(*Key);
+        Entry.UnusedNode = Unused.GetTail();
+    }
+
+    Trim();
+    return true;
+}
+
+void FFMODProgrammerSoundCache::Prefetch(FMOD::Studio::System *StudioSystem, const TArray<FString> &SoundNames)
+{
+    FScopeLock Lock(&Crit);
+
+    FMOD::System *CoreSystem = nullptr;
+    if (StudioSystem == nullptr || StudioSystem->getCoreSystem(&CoreSystem) != FMOD_OK)
+    {
+        return;
+    }
+
+    UpdateLoading();
+
+    for (const FString &SoundName : SoundNames)
+    {
+        FindOrCreate(StudioSystem, CoreSystem, SoundName);
+    }
+    Trim();
+}
+
+void FFMODProgrammerSoundCache::Reset(FMOD::System *CoreSystem)
+{
+    FScopeLock Lock(&Crit);
+
+    TArray<FKey> Keys;
+    for (const TPair<FKey, FEntry> &Pair : Entries)
+    {
+        if (Pair.Key.Get<0>() == CoreSystem)
+        {
+            Keys.Add(Pair.Key);
+        }
+    }
+
+    for (const FKey &Key : Keys)
+    {
+        Remove(Key, true);
+    }
+}
+
+FMOD::Sound *FFMODProgrammerSoundCache::CreateSound(
+    FMOD::Studio::System *StudioSystem, FMOD::System *CoreSystem, const FString &SoundName, int32 &OutSubsoundIndex, bool &bOutStream)
+{
+    // Sounds are loaded in the background, instruments wait for them to become ready
+    FMOD_MODE SoundMode = FMOD_LOOP_NORMAL | FMOD_CREATECOMPRESSEDSAMPLE | FMOD_NONBLOCKING;
+    FMOD::Sound *Sound = nullptr;
+
+    if (SoundName.Contains(TEXT(".")))
+    {
+        // Load via file
+        FString SoundPath = SoundName;
+        if (FPaths::IsRelative(SoundPath))
+        {
+            SoundPath = FPaths::ProjectContentDir() / SoundPath;
+        }
+
+        if (CoreSystem->createSound(TCHAR_TO_UTF8(*SoundPath), SoundMode, nullptr, &Sound) == FMOD_OK)
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound from file '%s'"), *SoundPath);
+            OutSubsoundIndex = -1;
+            bOutStream = false;
+        }
+        else
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to load programmer sound file '%s'"), *SoundPath);
+            return nullptr;
+        }
+    }
+    else
+    {
+        // Load via FMOD Studio asset table
+        FMOD_STUDIO_SOUND_INFO SoundInfo = { 0 };
+        FMOD_RESULT Result = StudioSystem->getSoundInfo(TCHAR_TO_UTF8(*SoundName), &SoundInfo);
+        if (Result != FMOD_OK)
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to find FMOD audio entry '%s'"), *SoundName);
+            return nullptr;
+        }
+
+        Result = CoreSystem->createSound(SoundInfo.name_or_data, SoundMode | SoundInfo.mode, &SoundInfo.exinfo, &Sound);
+        if (Result == FMOD_OK)
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound using audio entry '%s'"), *SoundName);
+            OutSubsoundIndex = SoundInfo.subsoundindex;
+            bOutStream = (SoundInfo.mode & FMOD_CREATESTREAM) != 0;
+        }
+        else
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to load FMOD audio entry '%s'"), *SoundName);
+            return nullptr;
+        }
+    }
+
+    return Sound;
+}
+
+FFMODProgrammerSoundCache::FEntry *FFMODProgrammerSoundCache::FindOrCreate(
+    FMOD::Studio::System *StudioSystem, FMOD::System *CoreSystem, const FString &SoundName)
+{
+    FKey Key(CoreSystem, SoundName);
+    FEntry *Entry = Entries.Find(Key);
+    if (Entry)
+    {
+        return Entry;
+    }
+
+    int32 SubsoundIndex = -1;
+    bool bStream = false;
+    FMOD::Sound *Sound = CreateSound(StudioSystem, CoreSystem, SoundName, SubsoundIndex, bStream);
+    if (Sound == nullptr)
+    {
+        return nullptr;
+    }
+
+    FEntry &NewEntry = Entries.Add(Key);
+    NewEntry.Sound = Sound;
+    NewEntry.SubsoundIndex = SubsoundIndex;
+    NewEntry.RefCount = 0;
+    NewEntry.Bytes = 0;
+    NewEntry.bReady = false;
+    NewEntry.bStream = bStream;
+    Unused.AddTail(Key);
+    NewEntry.UnusedNode = Unused.GetTail();
+    SoundKeys.Add(Sound, Key);
+    Loading.Add(Key);
+    return &NewEntry;
+}
+
+void FFMODProgrammerSoundCache::UpdateLoading()
+{
+    // Size is only known once loading has finished
+    for (int32 i = Loading.Num() - 1; i >= 0; --i)
+    {
+        const FKey Key = Loading[i];
+        FEntry &Entry = Entries.FindChecked(Key);
+
+        FMOD_OPENSTATE OpenState = FMOD_OPENSTATE_LOADING;
+        if (Entry.Sound->getOpenState(&OpenState, nullptr, nullptr, nullptr) != FMOD_OK || OpenState == FMOD_OPENSTATE_ERROR)
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to load programmer sound '%s'"), *Key.Get<1>());
+            Remove(Key, false);
+        }
+        else if (OpenState == FMOD_OPENSTATE_READY)
+        {
+            unsigned int Length = 0;
+            Entry.Sound->getLength(&Length, FMOD_TIMEUNIT_RAWBYTES);
+            Entry.Bytes = Length;
+            Entry.bReady = true;
+            TotalBytes += Entry.Bytes;
+            Loading.RemoveAtSwap(i);
+        }
+    }
+}
+
+void FFMODProgrammerSoundCache::Remove(const FKey &Key, bool bForceRelease)
+{
+    FEntry Entry = Entries.FindAndRemoveChecked(Key);
+    SoundKeys.Remove(Entry.Sound);
+
+    if (Entry.bReady)
+    {
+        TotalBytes -= Entry.Bytes;
+    }
+    else
+    {
+        Loading.RemoveSwap(Key);
+    }
+
+    if (Entry.UnusedNode)
+    {
+        Unused.RemoveNode(Entry.UnusedNode);
+    }
+
+    // Instruments still using the sound release it themselves, since Release no longer knows about it
+    if (Entry.RefCount == 0 || bForceRelease)
+    {
+        Entry.Sound->release();
+    }
+}
+
+void FFMODProgrammerSoundCache::Trim()
+{
+    UpdateLoading();
+
+    const uint64 Budget = (uint64)GetDefault<UFMODSettings>()->ProgrammerSoundCacheSize * 1024 * 1024;
+
+    // A budget of 0 keeps sounds only while instruments are using them
+    FKeyList::TDoubleLinkedListNode *Node = Unused.GetHead();
+    while (Node && (TotalBytes > Budget || Budget == 0))
+    {
+        FKeyList::TDoubleLinkedListNode *Next = Node->GetNextNode();
+
+        // Releasing a sound that is still loading would block until it finishes
+        const FKey Key = Node->GetValue();
+        if (Entries.FindChecked(Key).bReady)
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT("Releasing cached programmer sound '%s'"), *Key.Get<1>());
+            Remove(Key, false);
+        }
+        Node = Next;
+    }
+}
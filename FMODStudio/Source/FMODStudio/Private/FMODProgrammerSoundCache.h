@@ -0,0 +1,75 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/List.h"
+#include "Templates/Tuple.h"
+
+namespace FMOD
+{
+class Sound;
+class System;
+
+namespace Studio
+{
+class System;
+}
+}
+
+/**
+ * Shares sounds created for programmer instruments between event instances.  Sounds are keyed by the name given to
+ * the programmer instrument, which is either a file path or an audio table key, and are reference counted while
+ * instruments use them.  Unused sounds stay cached until the memory budget is exceeded, oldest first, so repeated
+ * lines don't have to be reloaded.  Streams can only play on one instrument at a time, so a stream that is already in
+ * use is handed out as a separate uncached sound instead.  Safe to use from FMOD callbacks.
+ */
+class FFMODProgrammerSoundCache
+{
+public:
+    FFMODProgrammerSoundCache();
+
+    static FFMODProgrammerSoundCache &Get();
+
+    /** Returns a sound for a programmer instrument, loading it if needed.  Each successful call must be matched with a Release. */
+    FMOD::Sound *Acquire(FMOD::Studio::System *StudioSystem, const FString &SoundName, int32 &OutSubsoundIndex);
+
+    /** Give back a sound returned by Acquire.  Returns false if the sound isn't from the cache, the caller must release it. */
+    bool Release(FMOD::Sound *Sound);
+
+    /** Start loading sounds in the background so that they are ready when their instruments are triggered */
+    void Prefetch(FMOD::Studio::System *StudioSystem, const TArray<FString> &SoundNames);
+
+    /** Release every cached sound belonging to a core system that is about to go away */
+    void Reset(FMOD::System *CoreSystem);
+
+private:
+    typedef TTuple<FMOD::System *, FString> FKey;
+
+    typedef TDoubleLinkedList<FKey> FKeyList;
+
+    struct FEntry
+    {
+        FMOD::Sound *Sound;
+        int32 SubsoundIndex;
+        int32 RefCount;
+        uint32 Bytes;
+        bool bReady;
+        bool bStream;
+        FKeyList::TDoubleLinkedListNode *UnusedNode; // Position in the eviction order while no instrument uses the sound
+    };
+
+    static FMOD::Sound *CreateSound(
+        FMOD::Studio::System *StudioSystem, FMOD::System *CoreSystem, const FString &SoundName, int32 &OutSubsoundIndex, bool &bOutStream);
+    FEntry *FindOrCreate(FMOD::Studio::System *StudioSystem, FMOD::System *CoreSystem, const FString &SoundName);
+    void UpdateLoading();
+    void Remove(const FKey &Key, bool bForceRelease);
+    void Trim();
+
+    FCriticalSection Crit;
+    TMap<FKey, FEntry> Entries;
+    TMap<FMOD::Sound *, FKey> SoundKeys;
+    FKeyList Unused; // Least recently used first
+    TArray<FKey> Loading;
+    uint64 TotalBytes;
+};
@@ -31,11 +31,34 @@ UFMODSettings::UFMODSettings(const FObjectInitializer &ObjectInitializer)
     DSPBufferLength = 0;
     DSPBufferCount = 0;
     FileBufferSize = 2048;
+    bAsyncFileReads = false;
+    AsyncFileReadThreads = 2;
     StudioUpdatePeriod = 0;
+    bUseDedicatedUpdateThread = false;
+    UpdateThreadRate = 60.0f;
+    bUpdateFromTaskGraph = false;
+    bUseCommandBuffer = false;
+    bThreadUnsafeRuntimeSystem = false;
     LiveUpdatePort = 9264;
     EditorLiveUpdatePort = 9265;
     bMatchHardwareSampleRate = true;
     bLockAllBuses = false;
+    bMemoryMapBanks = false;
+    bInitializeAsynchronously = false;
+    bKeepRuntimeSystemBetweenPIESessions = false;
+    bUsePooledAllocator = false;
+    bLazyAssetCreation = false;
+    bBatch3DAttributes = false;
+    EmitterMoveThreshold = 1.0f;
+    EmitterRotationThreshold = 1.0f;
+    bVirtualizeInaudibleComponents = false;
+    VirtualizationInterval = 0.25f;
+    VirtualizationMargin = 0.1f;
+    MaxRealComponents = 0;
+    OcclusionTraceBudget = 32;
+    OcclusionSmoothingTime = 0.2f;
+    ProgrammerSoundCacheSize = 16;
+    bPreloadLevelBanks = false;
 }
 
 FString UFMODSettings::GetFullBankPath() const
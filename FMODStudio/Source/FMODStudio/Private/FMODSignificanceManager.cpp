@@ -0,0 +1,125 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODSignificanceManager.h"
+#include "FMODAudioComponent.h"
+#include "FMODListener.h"
+#include "FMODSettings.h"
+#include "FMODStudioModule.h"
+#include "FMODUtils.h"
+#include "FMODStudioPrivatePCH.h"
+
+FFMODSignificanceManager::FFMODSignificanceManager()
+    : TimeSinceUpdate(0.0f)
+{
+}
+
+FFMODSignificanceManager &FFMODSignificanceManager::Get()
+{
+    static FFMODSignificanceManager Instance;
+    return Instance;
+}
+
+void FFMODSignificanceManager::Register(UFMODAudioComponent *Component)
+{
+    Components.Add(Component);
+}
+
+void FFMODSignificanceManager::Update(float DeltaTime)
+{
+    if (Components.Num() == 0)
+    {
+        return;
+    }
+
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    if (!Settings.bVirtualizeInaudibleComponents)
+    {
+        // Turned off at runtime, so bring everything back
+        Reset(true);
+        return;
+    }
+
+    TimeSinceUpdate += DeltaTime;
+    if (TimeSinceUpdate < Settings.VirtualizationInterval)
+    {
+        return;
+    }
+    TimeSinceUpdate = 0.0f;
+
+    IFMODStudioModule &Module = IFMODStudioModule::Get();
+
+    Candidates.Reset();
+    for (TSet<TWeakObjectPtr<UFMODAudioComponent>>::TIterator It(Components); It; ++It)
+    {
+        UFMODAudioComponent *Component = It->Get();
+        if (Component == nullptr || (!Component->bVirtual && (!Component->IsActive() || Component->StudioInstance == nullptr)))
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        const float MaximumDistance = FMODUtils::DistanceToUEScale(Component->GetVirtualizationDistance());
+        if (MaximumDistance <= 0.0f)
+        {
+            continue;
+        }
+
+        const FVector Location = Component->GetComponentLocation();
+        const FFMODListener &Listener = Module.GetNearestListener(Location);
+        FCandidate Candidate;
+        Candidate.Component = Component;
+        Candidate.Audibility = FVector::Dist(Location, Listener.Transform.GetTranslation()) / MaximumDistance;
+        Candidates.Add(Candidate);
+    }
+
+    // Closest relative to their range first, so a real component budget keeps the most audible ones
+    Candidates.Sort([](const FCandidate &A, const FCandidate &B) { return A.Audibility < B.Audibility; });
+
+    int32 RealCount = 0;
+    for (const FCandidate &Candidate : Candidates)
+    {
+        UFMODAudioComponent *Component = Candidate.Component;
+
+        // Real components are allowed a little past their range so that emitters on the boundary don't flip every update
+        const float Limit = Component->bVirtual ? 1.0f : 1.0f + Settings.VirtualizationMargin;
+        const bool bWithinBudget = Settings.MaxRealComponents <= 0 || RealCount < Settings.MaxRealComponents;
+
+        if (Candidate.Audibility < Limit && bWithinBudget)
+        {
+            if (Component->bVirtual)
+            {
+                Component->Devirtualize();
+            }
+            ++RealCount;
+        }
+        else if (!Component->bVirtual)
+        {
+            Component->Virtualize();
+        }
+    }
+}
+
+void FFMODSignificanceManager::Reset(bool bRestore)
+{
+    // Restarting a component registers it again, so work from a copy
+    TArray<TWeakObjectPtr<UFMODAudioComponent>> Tracked = Components.Array();
+    Components.Reset();
+    TimeSinceUpdate = 0.0f;
+
+    for (const TWeakObjectPtr<UFMODAudioComponent> &WeakComponent : Tracked)
+    {
+        UFMODAudioComponent *Component = WeakComponent.Get();
+        if (Component && Component->bVirtual)
+        {
+            if (bRestore)
+            {
+                Component->Devirtualize();
+            }
+            else
+            {
+                // Completes on the component's next tick, as a stopped real instance would
+                Component->Stop();
+            }
+        }
+    }
+}
@@ -0,0 +1,47 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UFMODAudioComponent;
+
+/**
+ * Ranks playing looping 3D audio components by distance to the nearest listener relative to their maximum distance.
+ * Components that are out of range, or beyond the configured number of real components, have their event instance
+ * released and are restarted from an estimated timeline position once they become audible again.
+ * Must only be used from the game thread.
+ */
+class FFMODSignificanceManager
+{
+public:
+    static FFMODSignificanceManager &Get();
+
+    /** Start tracking a component that has just started playing */
+    void Register(UFMODAudioComponent *Component);
+
+    /** Re-evaluate which components should hold an event instance.  Called once per frame. */
+    void Update(float DeltaTime);
+
+    /**
+     * Stop tracking everything.  Virtual components are restarted when bRestore is set, otherwise they finish
+     * as if they had been stopped, which is what happens when the Studio system is going away.
+     */
+    void Reset(bool bRestore);
+
+private:
+    FFMODSignificanceManager();
+
+    struct FCandidate
+    {
+        UFMODAudioComponent *Component;
+        float Audibility;
+    };
+
+    TSet<TWeakObjectPtr<UFMODAudioComponent>> Components;
+    float TimeSinceUpdate;
+
+    // Scratch space reused between updates
+    TArray<FCandidate> Candidates;
+};
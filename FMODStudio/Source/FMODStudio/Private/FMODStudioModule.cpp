@@ -6,13 +6,29 @@
 #include "FMODBlueprintStatics.h"
 #include "FMODAssetTable.h"
 #include "FMODFileCallbacks.h"
+#include "FMODBankLoader.h"
+#include "FMODBankManager.h"
 #include "FMODBankUpdateNotifier.h"
+#include "FMODCommandBuffer.h"
+#include "FMODUpdateThread.h"
+#include "FMODEmitterManager.h"
+#include "FMODEventDescriptionCache.h"
+#include "FMODInstancePool.h"
+#include "FMODLevelPreloader.h"
+#include "FMODMemoryAllocator.h"
+#include "FMODSignificanceManager.h"
+#include "FMODOcclusionManager.h"
+#include "FMODPlaybackCompletionQueue.h"
+#include "FMODProgrammerSoundCache.h"
 #include "FMODUtils.h"
 #include "FMODEvent.h"
+#include "FMODBus.h"
+#include "FMODVCA.h"
 #include "FMODListener.h"
 #include "FMODSnapshotReverb.h"
 
 #include "Async/Async.h"
+#include "Async/TaskGraphInterfaces.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/App.h"
 #include "Misc/CommandLine.h"
@@ -51,24 +67,52 @@ DECLARE_FLOAT_COUNTER_STAT(TEXT("FMOD CPU - Mixer"), STAT_FMOD_CPUMixer, STATGRO
 DECLARE_FLOAT_COUNTER_STAT(TEXT("FMOD CPU - Studio"), STAT_FMOD_CPUStudio, STATGROUP_FMOD);
 DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Current"), STAT_FMOD_Current_Memory, STATGROUP_FMOD);
 DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Max"), STAT_FMOD_Max_Memory, STATGROUP_FMOD);
+DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Normal"), STAT_FMOD_Memory_Normal, STATGROUP_FMOD);
+DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Stream File"), STAT_FMOD_Memory_StreamFile, STATGROUP_FMOD);
+DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Stream Decode"), STAT_FMOD_Memory_StreamDecode, STATGROUP_FMOD);
+DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Sample Data"), STAT_FMOD_Memory_SampleData, STATGROUP_FMOD);
+DECLARE_MEMORY_STAT(TEXT("FMOD Memory - DSP Buffer"), STAT_FMOD_Memory_DSPBuffer, STATGROUP_FMOD);
+DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Plugin"), STAT_FMOD_Memory_Plugin, STATGROUP_FMOD);
+DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Persistent"), STAT_FMOD_Memory_Persistent, STATGROUP_FMOD);
+DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Pool Reserved"), STAT_FMOD_Memory_PoolReserved, STATGROUP_FMOD);
 DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Channels - Total"), STAT_FMOD_Total_Channels, STATGROUP_FMOD);
 DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Channels - Real"), STAT_FMOD_Real_Channels, STATGROUP_FMOD);
+DECLARE_MEMORY_STAT(TEXT("FMOD Sample Data - Loaded"), STAT_FMOD_SampleData_Loaded, STATGROUP_FMOD);
+DECLARE_MEMORY_STAT(TEXT("FMOD Sample Data - Unreferenced"), STAT_FMOD_SampleData_Cached, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Banks - Managed"), STAT_FMOD_Managed_Banks, STATGROUP_FMOD);
 
 const TCHAR *FMODSystemContextNames[EFMODSystemContext::Max] = {
     TEXT("Auditioning"), TEXT("Runtime"), TEXT("Editor"),
 };
 
-void *F_CALLBACK FMODMemoryAlloc(unsigned int size, FMOD_MEMORY_TYPE type, const char *sourcestr)
+// Bumped whenever Studio handles cached on assets may have become invalid
+static FThreadSafeCounter StudioHandleGeneration(1);
+
+template <typename HandleType>
+static HandleType *FindCachedHandle(const UFMODAsset *Asset, EFMODSystemContext::Type Context)
 {
-    return FMemory::Malloc(size);
+    if (Asset->CachedHandleGenerations[Context] == (uint32)StudioHandleGeneration.GetValue())
+    {
+        return (HandleType *)Asset->CachedHandles[Context];
+    }
+    return nullptr;
 }
-void *F_CALLBACK FMODMemoryRealloc(void *ptr, unsigned int size, FMOD_MEMORY_TYPE type, const char *sourcestr)
+
+static void StoreCachedHandle(const UFMODAsset *Asset, EFMODSystemContext::Type Context, void *Handle)
 {
-    return FMemory::Realloc(ptr, size);
+    Asset->CachedHandles[Context] = Handle;
+    Asset->CachedHandleGenerations[Context] = StudioHandleGeneration.GetValue();
 }
-void F_CALLBACK FMODMemoryFree(void *ptr, FMOD_MEMORY_TYPE type, const char *sourcestr)
+
+FMOD_RESULT F_CALLBACK FMODStudioSystemCallback(FMOD_STUDIO_SYSTEM *system, FMOD_STUDIO_SYSTEM_CALLBACK_TYPE type, void *commanddata, void *userdata)
 {
-    FMemory::Free(ptr);
+    if (type == FMOD_STUDIO_SYSTEM_CALLBACK_BANK_UNLOAD)
+    {
+        StudioHandleGeneration.Increment();
+        FFMODEventDescriptionCache::Get().Invalidate();
+        FMODReleaseBankMemory((FMOD::Studio::Bank *)commanddata);
+    }
+    return FMOD_OK;
 }
 
 struct FFMODSnapshotEntry
@@ -123,6 +167,9 @@ public:
     FFMODStudioSystemClockSink(FMOD::Studio::System *SystemIn)
         : System(SystemIn)
         , LastResult(FMOD_OK)
+        , bUpdateSystem(true)
+        , bUpdateOnTaskGraph(false)
+        , TaskResult(FMOD_OK)
     {
     }
 
@@ -135,17 +182,57 @@ public:
                 UpdateListenerPosition.Execute();
             }
 
-            LastResult = System->update();
+            FFMODEmitterManager::Get().Flush();
+            FFMODCommandBuffer::Get().Flush();
+
+            if (bUpdateSystem && bUpdateOnTaskGraph)
+            {
+                // Updates must not overlap, the previous one has normally finished long before the next frame's submission
+                WaitForUpdate();
+                UpdateTask = FFunctionGraphTask::CreateAndDispatchWhenReady(
+                    [this]() { TaskResult = System->update(); }, TStatId(), nullptr, ENamedThreads::AnyHiPriThreadNormalTask);
+            }
+            else if (bUpdateSystem)
+            {
+                LastResult = System->update();
+            }
+        }
+    }
+
+    /** Wait for an update running on the task graph, and pick up its result */
+    void WaitForUpdate()
+    {
+        if (UpdateTask.IsValid())
+        {
+            FTaskGraphInterface::Get().WaitUntilTaskCompletes(UpdateTask, ENamedThreads::GameThread_Local);
+            UpdateTask = nullptr;
+            LastResult = TaskResult;
         }
     }
 
     void SetUpdateListenerPositionDelegate(FUpdateListenerPosition UpdateListenerPositionIn) { UpdateListenerPosition = UpdateListenerPositionIn; }
 
-    void OnDestroyStudioSystem() { System = nullptr; }
+    void OnDestroyStudioSystem()
+    {
+        WaitForUpdate();
+        System = nullptr;
+    }
 
     FMOD::Studio::System *System;
     FMOD_RESULT LastResult;
     FUpdateListenerPosition UpdateListenerPosition;
+
+    /** False when the system is updated from a dedicated update thread instead */
+    bool bUpdateSystem;
+
+    /** True when update() is dispatched to the task graph instead of being called from the media clock */
+    bool bUpdateOnTaskGraph;
+
+private:
+    FGraphEventRef UpdateTask;
+
+    /** Written by the update task, only read once it has completed */
+    FMOD_RESULT TaskResult;
 };
 
 class FFMODStudioModule : public IFMODStudioModule
@@ -161,6 +248,9 @@ public:
         , bListenerMoved(true)
         , bAllowLiveUpdate(true)
         , bBanksLoaded(false)
+        , bAsyncInitPending(false)
+        , bPauseRequested(false)
+        , bRuntimeSystemParked(false)
         , LowLevelLibHandle(nullptr)
         , StudioLibHandle(nullptr)
         , bMixerPaused(false)
@@ -169,6 +259,7 @@ public:
         for (int i = 0; i < EFMODSystemContext::Max; ++i)
         {
             StudioSystem[i] = nullptr;
+            bCreateOnDemand[i] = false;
         }
     }
 
@@ -195,15 +286,45 @@ public:
     /** Called when a newer version of the bank files was detected */
     void HandleBanksUpdated();
 
+    /** Unloads and reloads just the given banks on a live system */
+    void ReloadChangedBanks(EFMODSystemContext::Type Type, const TArray<FString> &ChangedBanks, FFMODBankChanges &Changes);
+
     void CreateStudioSystem(EFMODSystemContext::Type Type);
     void DestroyStudioSystem(EFMODSystemContext::Type Type);
 
+    /** Creates and initializes the FMOD side of a Studio system.  Safe to call off the game thread. */
+    void InitializeStudioSystem(EFMODSystemContext::Type Type);
+
+    /** Hooks an initialized Studio system up to the engine.  Game thread only. */
+    void RegisterStudioSystem(EFMODSystemContext::Type Type);
+
+    /** Marks the settings' pooled events and prewarms their instances on the runtime system */
+    void ApplyPooledEvents();
+
+    /** Creates the runtime system and loads its banks on a background thread */
+    void StartAsyncInitialization();
+
+    /** Finishes on the game thread once the background initialization is done, and runs anything queued until then */
+    void FinishAsyncInitialization();
+
+    /** Clears what a PIE session left on the runtime system, keeping the system and its startup banks for the next session */
+    void ParkRuntimeSystem();
+
     bool Tick(float DeltaTime);
 
+    /** Polls the loading state of banks requested through LoadBanksAsync */
+    void UpdateBankLoadRequests();
+
+    /** Marks every pending bank load request as failed and notifies its listeners */
+    void FailBankLoadRequests();
+
     void UpdateViewportPosition();
 
     virtual FMOD::Studio::System *GetStudioSystem(EFMODSystemContext::Type Context) override;
+    virtual bool HasStudioSystem(EFMODSystemContext::Type Context) override;
     virtual FMOD::Studio::EventDescription *GetEventDescription(const UFMODEvent *Event, EFMODSystemContext::Type Type) override;
+    virtual FMOD::Studio::Bus *GetBus(const UFMODBus *Bus, EFMODSystemContext::Type Context) override;
+    virtual FMOD::Studio::VCA *GetVCA(const UFMODVCA *Vca, EFMODSystemContext::Type Context) override;
     virtual FMOD::Studio::EventInstance *CreateAuditioningInstance(const UFMODEvent *Event) override;
     virtual void StopAuditioningInstance() override;
 
@@ -222,11 +343,14 @@ public:
 
     virtual UFMODAsset *FindAssetByName(const FString &Name) override;
     virtual UFMODEvent *FindEventByName(const FString &Name) override;
+    virtual UFMODAsset *FindAssetByPath(const FSoftObjectPath &Path) override;
     virtual FString GetBankPath(const UFMODBank &Bank) override;
+    virtual void GetBanksContainingEvents(const TSet<FGuid> &EventGuids, TArray<UFMODBank *> &OutBanks) override;
+    virtual TSharedRef<FFMODBankLoadRequest> LoadBanksAsync(const TArray<UFMODBank *> &Banks, bool bLoadSampleData) override;
     virtual void GetAllBankPaths(TArray<FString> &Paths, bool IncludeMasterBank) const override;
 
-    FSimpleMulticastDelegate BanksReloadedDelegate;
-    virtual FSimpleMulticastDelegate &BanksReloadedEvent() override { return BanksReloadedDelegate; }
+    FFMODBanksReloadedDelegate BanksReloadedDelegate;
+    virtual FFMODBanksReloadedDelegate &BanksReloadedEvent() override { return BanksReloadedDelegate; }
 
     virtual TArray<FString> GetFailedBankLoads(EFMODSystemContext::Type Context) override { return FailedBankLoads[Context]; }
 
@@ -248,6 +372,10 @@ public:
 
     virtual bool AreBanksLoaded() override;
 
+    virtual bool IsSystemReady() override { return !bAsyncInitPending; }
+
+    virtual void QueueUntilReady(TFunction<void()> Callback) override;
+
     virtual bool SetLocale(const FString& Locale) override;
 
     void ResetInterpolation();
@@ -262,6 +390,12 @@ public:
     /** IMediaClockSink wrappers for Studio Systems */
     TSharedPtr<FFMODStudioSystemClockSink, ESPMode::ThreadSafe> ClockSinks[EFMODSystemContext::Max];
 
+    /** Updates the runtime system when it isn't updated from the media clock */
+    TUniquePtr<FFMODUpdateThread> UpdateThread;
+
+    /** Listener attributes waiting to be handed to the update thread */
+    FFMODListenerAttributes PendingListenerAttributes;
+
     /** Handle for registered TickDelegate. */
     FDelegateHandle TickDelegateHandle;
 
@@ -274,6 +408,12 @@ public:
     /** List of failed bank files */
     TArray<FString> FailedBankLoads[EFMODSystemContext::Max];
 
+    /** Banks loaded by LoadBanks, keyed by full path */
+    TMap<FString, FMOD::Studio::Bank *> LoadedBanks[EFMODSystemContext::Max];
+
+    /** Asynchronous bank loads that have not completed yet */
+    TArray<TSharedRef<FFMODBankLoadRequest>> BankLoadRequests;
+
     /** List of required plugins we found when loading banks. */
     TArray<FString> RequiredPlugins;
 
@@ -306,6 +446,24 @@ public:
 
     bool bBanksLoaded;
 
+    /** True while the runtime system is being created in the background */
+    bool bAsyncInitPending;
+
+    /** Completes when the background initialization has finished */
+    TFuture<void> AsyncInitResult;
+
+    /** Work waiting for the background initialization to finish */
+    TArray<TFunction<void()>> ReadyCallbacks;
+
+    /** Pause state asked for by application deactivation during the background initialization */
+    bool bPauseRequested;
+
+    /** True while the runtime system is kept warm between PIE sessions */
+    bool bRuntimeSystemParked;
+
+    /** Systems that are only created the first time they are asked for */
+    bool bCreateOnDemand[EFMODSystemContext::Max];
+
     /** Dynamic library */
     FString BaseLibPath;
     void *LowLevelLibHandle;
@@ -494,7 +652,9 @@ void FFMODStudioModule::StartupModule()
         }
         else
         {
-            verifyfmod(FMOD::Memory_Initialize(0, 0, FMODMemoryAlloc, FMODMemoryRealloc, FMODMemoryFree));
+            FFMODMemoryAllocator::Get().Initialize(Settings.bUsePooledAllocator);
+            verifyfmod(FMOD::Memory_Initialize(
+                0, 0, &FFMODMemoryAllocator::Alloc, &FFMODMemoryAllocator::Realloc, &FFMODMemoryAllocator::Free));
         }
 
         verifyfmod(FMODPlatformSystemSetup());
@@ -507,20 +667,37 @@ void FFMODStudioModule::StartupModule()
 
         if (GIsEditor)
         {
-            CreateStudioSystem(EFMODSystemContext::Auditioning);
-            CreateStudioSystem(EFMODSystemContext::Editor);
+            // Most editor sessions never audition or preview anything, so don't pay for the systems and their banks until then
+            bCreateOnDemand[EFMODSystemContext::Auditioning] = true;
+            bCreateOnDemand[EFMODSystemContext::Editor] = true;
+
+            if (Settings.bEnableEditorLiveUpdate)
+            {
+                // Live update connects to the auditioning system, so it needs to exist from the start
+                CreateStudioSystem(EFMODSystemContext::Auditioning);
+                LoadBanks(EFMODSystemContext::Auditioning);
+            }
         }
         else
         {
             AssetTable.Destroy(); // Don't need this copy around since we don't hot reload
 
-            SetInPIE(true, false);
+            if (Settings.bInitializeAsynchronously)
+            {
+                StartAsyncInitialization();
+            }
+            else
+            {
+                SetInPIE(true, false);
+            }
         }
     }
 
     OnTick = FTickerDelegate::CreateRaw(this, &FFMODStudioModule::Tick);
     TickDelegateHandle = FTicker::GetCoreTicker().AddTicker(OnTick);
 
+    FFMODLevelPreloader::Get().Startup();
+
     if (GIsEditor)
     {
         BankUpdateNotifier.BanksUpdatedEvent.AddRaw(this, &FFMODStudioModule::HandleBanksUpdated);
@@ -551,6 +728,12 @@ void FFMODStudioModule::CreateStudioSystem(EFMODSystemContext::Type Type)
         return;
     }
 
+    InitializeStudioSystem(Type);
+    RegisterStudioSystem(Type);
+}
+
+void FFMODStudioModule::InitializeStudioSystem(EFMODSystemContext::Type Type)
+{
     UE_LOG(LogFMOD, Verbose, TEXT("CreateStudioSystem for context %s"), FMODSystemContextNames[Type]);
 
     const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
@@ -573,6 +756,24 @@ void FFMODStudioModule::CreateStudioSystem(EFMODSystemContext::Type Type)
     {
         StudioInitFlags |= FMOD_STUDIO_INIT_ALLOW_MISSING_PLUGINS;
     }
+    if (Type == EFMODSystemContext::Runtime && Settings.bUseCommandBuffer && Settings.bThreadUnsafeRuntimeSystem)
+    {
+        // Only safe when every call is made from the game thread
+        if (Settings.bUseDedicatedUpdateThread || Settings.bUpdateFromTaskGraph || (Settings.bInitializeAsynchronously && !GIsEditor))
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Thread unsafe runtime system ignored, it can't be combined with other threads updating or initializing FMOD"));
+        }
+        else
+        {
+            StudioInitFlags |= FMOD_STUDIO_INIT_SYNCHRONOUS_UPDATE;
+            InitFlags |= FMOD_INIT_THREAD_UNSAFE;
+        }
+    }
+    if (Type == EFMODSystemContext::Runtime && Settings.bUpdateFromTaskGraph && !Settings.bUseDedicatedUpdateThread)
+    {
+        // Studio processing happens inside update(), which runs on the task graph
+        StudioInitFlags |= FMOD_STUDIO_INIT_SYNCHRONOUS_UPDATE;
+    }
 
     verifyfmod(FMOD::Studio::System::create(&StudioSystem[Type]));
     FMOD::System *lowLevelSystem = nullptr;
@@ -625,7 +826,9 @@ void FFMODStudioModule::CreateStudioSystem(EFMODSystemContext::Type Type)
 
     verifyfmod(lowLevelSystem->setSoftwareFormat(SampleRate, OutputMode, 0));
     verifyfmod(lowLevelSystem->setSoftwareChannels(Settings.RealChannelCount));
-    AttachFMODFileSystem(lowLevelSystem, Settings.FileBufferSize);
+    // Only the runtime system streams enough to benefit from asynchronous reads
+    const bool bAsyncReads = Type == EFMODSystemContext::Runtime && Settings.bAsyncFileReads;
+    AttachFMODFileSystem(lowLevelSystem, Settings.FileBufferSize, bAsyncReads ? Settings.AsyncFileReadThreads : 0);
 
     if (Settings.DSPBufferLength > 0 && Settings.DSPBufferCount > 0)
     {
@@ -673,12 +876,18 @@ void FFMODStudioModule::CreateStudioSystem(EFMODSystemContext::Type Type)
     verifyfmod(StudioSystem[Type]->setAdvancedSettings(&advStudioSettings));
 
     verifyfmod(StudioSystem[Type]->initialize(Settings.TotalChannelCount, StudioInitFlags, InitFlags, InitData));
+    verifyfmod(StudioSystem[Type]->setCallback(FMODStudioSystemCallback, FMOD_STUDIO_SYSTEM_CALLBACK_BANK_UNLOAD));
 
     for (FString PluginName : Settings.PluginFiles)
     {
         if (!PluginName.IsEmpty())
             LoadPlugin(Type, *PluginName);
     }
+}
+
+void FFMODStudioModule::RegisterStudioSystem(EFMODSystemContext::Type Type)
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
 
     if (Type == EFMODSystemContext::Runtime)
     {
@@ -687,6 +896,12 @@ void FFMODStudioModule::CreateStudioSystem(EFMODSystemContext::Type Type)
         FCoreDelegates::ApplicationHasReactivatedDelegate.AddRaw(this, &FFMODStudioModule::HandleApplicationHasReactivated);
     }
 
+    if (Type == EFMODSystemContext::Runtime && Settings.bUseDedicatedUpdateThread)
+    {
+        PendingListenerAttributes = FFMODListenerAttributes();
+        UpdateThread = MakeUnique<FFMODUpdateThread>(StudioSystem[Type], Settings.UpdateThreadRate);
+    }
+
     IMediaModule *MediaModule = FModuleManager::LoadModulePtr<IMediaModule>("Media");
 
     if (MediaModule != nullptr)
@@ -696,16 +911,71 @@ void FFMODStudioModule::CreateStudioSystem(EFMODSystemContext::Type Type)
         if (Type == EFMODSystemContext::Runtime)
         {
             ClockSinks[Type]->SetUpdateListenerPositionDelegate(FTimerDelegate::CreateRaw(this, &FFMODStudioModule::UpdateViewportPosition));
+            ClockSinks[Type]->bUpdateSystem = !UpdateThread.IsValid();
+            ClockSinks[Type]->bUpdateOnTaskGraph = Settings.bUpdateFromTaskGraph && !UpdateThread.IsValid();
         }
 
         MediaModule->GetClock().AddSink(ClockSinks[Type].ToSharedRef());
     }
 }
 
+static void ReleaseAllInstances(FMOD::Studio::System *System)
+{
+    int bankCount = 0;
+    verifyfmod(System->getBankCount(&bankCount));
+    if (bankCount == 0)
+    {
+        return;
+    }
+
+    TArray<FMOD::Studio::Bank *> bankArray;
+    TArray<FMOD::Studio::EventDescription *> eventArray;
+    TArray<FMOD::Studio::EventInstance *> instanceArray;
+
+    bankArray.SetNumUninitialized(bankCount, false);
+    verifyfmod(System->getBankList(bankArray.GetData(), bankCount, &bankCount));
+    for (int i = 0; i < bankCount; i++)
+    {
+        int eventCount;
+        verifyfmod(bankArray[i]->getEventCount(&eventCount));
+        if (eventCount > 0)
+        {
+            eventArray.SetNumUninitialized(eventCount, false);
+            verifyfmod(bankArray[i]->getEventList(eventArray.GetData(), eventCount, &eventCount));
+            for (int j = 0; j < eventCount; j++)
+            {
+                int instanceCount;
+                verifyfmod(eventArray[j]->getInstanceCount(&instanceCount));
+                if (instanceCount > 0)
+                {
+                    instanceArray.SetNumUninitialized(instanceCount, false);
+                    verifyfmod(eventArray[j]->getInstanceList(instanceArray.GetData(), instanceCount, &instanceCount));
+                    for (int k = 0; k < instanceCount; k++)
+                    {
+                        verifyfmod(instanceArray[k]->stop(FMOD_STUDIO_STOP_IMMEDIATE));
+                        verifyfmod(instanceArray[k]->release());
+                    }
+                }
+            }
+        }
+    }
+}
+
 void FFMODStudioModule::DestroyStudioSystem(EFMODSystemContext::Type Type)
 {
+    if (Type == EFMODSystemContext::Runtime)
+    {
+        bRuntimeSystemParked = false;
+
+        // The next runtime system starts with its mixer running
+        bMixerPaused = false;
+    }
+
     UE_LOG(LogFMOD, Verbose, TEXT("DestroyStudioSystem for context %s"), FMODSystemContextNames[Type]);
 
+    // Recorded calls may refer to instances of this system
+    FFMODCommandBuffer::Get().Flush();
+
     if (ClockSinks[Type].IsValid())
     {
         // Calling through the shared ptr enforces thread safety with the media clock
@@ -721,6 +991,11 @@ void FFMODStudioModule::DestroyStudioSystem(EFMODSystemContext::Type Type)
         ClockSinks[Type].Reset();
     }
 
+    if (Type == EFMODSystemContext::Runtime)
+    {
+        UpdateThread.Reset();
+    }
+
     // Unload all events and banks to remove warning spam when using split banks
     if (StudioSystem[Type] && bLoadAllSampleData)
     {
@@ -729,36 +1004,10 @@ void FFMODStudioModule::DestroyStudioSystem(EFMODSystemContext::Type Type)
         if (bankCount > 0)
         {
             TArray<FMOD::Studio::Bank *> bankArray;
-            TArray<FMOD::Studio::EventDescription *> eventArray;
-            TArray<FMOD::Studio::EventInstance *> instanceArray;
 
             bankArray.SetNumUninitialized(bankCount, false);
             verifyfmod(StudioSystem[Type]->getBankList(bankArray.GetData(), bankCount, &bankCount));
-            for (int i = 0; i < bankCount; i++)
-            {
-                int eventCount;
-                verifyfmod(bankArray[i]->getEventCount(&eventCount));
-                if (eventCount > 0)
-                {
-                    eventArray.SetNumUninitialized(eventCount, false);
-                    verifyfmod(bankArray[i]->getEventList(eventArray.GetData(), eventCount, &eventCount));
-                    for (int j = 0; j < eventCount; j++)
-                    {
-                        int instanceCount;
-                        verifyfmod(eventArray[j]->getInstanceCount(&instanceCount));
-                        if (instanceCount > 0)
-                        {
-                            instanceArray.SetNumUninitialized(instanceCount, false);
-                            verifyfmod(eventArray[j]->getInstanceList(instanceArray.GetData(), instanceCount, &instanceCount));
-                            for (int k = 0; k < instanceCount; k++)
-                            {
-                                verifyfmod(instanceArray[k]->stop(FMOD_STUDIO_STOP_IMMEDIATE));
-                                verifyfmod(instanceArray[k]->release());
-                            }
-                        }
-                    }
-                }
-            }
+            ReleaseAllInstances(StudioSystem[Type]);
 
             for (int i = 0; i < bankCount; i++)
             {
@@ -772,11 +1021,43 @@ void FFMODStudioModule::DestroyStudioSystem(EFMODSystemContext::Type Type)
         }
     }
 
+    if (Type == EFMODSystemContext::Runtime)
+    {
+        FFMODPlaybackCompletionQueue::Get().Reset();
+
+        // Only runtime instances are pooled
+        FFMODInstancePool::Get().Reset();
+        FailBankLoadRequests();
+        FFMODLevelPreloader::Get().Reset(false);
+        FFMODBankManager::Get().Reset(false);
+        FFMODSignificanceManager::Get().Reset(false);
+        FFMODOcclusionManager::Get().Reset();
+    }
+
     if (StudioSystem[Type])
     {
+        // Unload explicitly so the bank unload callback can release any memory mapped banks
+        verifyfmod(StudioSystem[Type]->unloadAll());
+        verifyfmod(StudioSystem[Type]->flushCommands());
+
+        FMOD::System *CoreSystem = nullptr;
+        if (StudioSystem[Type]->getCoreSystem(&CoreSystem) == FMOD_OK)
+        {
+            FFMODProgrammerSoundCache::Get().Reset(CoreSystem);
+        }
         verifyfmod(StudioSystem[Type]->release());
         StudioSystem[Type] = nullptr;
+        StudioHandleGeneration.Increment();
+        FFMODEventDescriptionCache::Get().Invalidate();
+
+        if (Type != EFMODSystemContext::Runtime)
+        {
+            // Editor previews played on this system won't get a stopped callback now
+            FFMODPlaybackCompletionQueue::Get().OrphanInvalidInstances();
+        }
     }
+
+    LoadedBanks[Type].Reset();
 }
 
 bool FFMODStudioModule::Tick(float DeltaTime)
@@ -786,6 +1067,21 @@ bool FFMODStudioModule::Tick(float DeltaTime)
         BankUpdateNotifier.Update();
     }
 
+    if (bAsyncInitPending && AsyncInitResult.IsReady())
+    {
+        FinishAsyncInitialization();
+    }
+
+    // Playback states are polled below, which don't reflect starts that are still recorded
+    FFMODCommandBuffer::Get().Flush();
+
+    FFMODPlaybackCompletionQueue::Get().Update();
+    FFMODInstancePool::Get().Update();
+    FFMODSignificanceManager::Get().Update(DeltaTime);
+    FFMODOcclusionManager::Get().Update(DeltaTime);
+    UpdateBankLoadRequests();
+    FFMODLevelPreloader::Get().Update();
+
     if (ClockSinks[EFMODSystemContext::Auditioning].IsValid())
     {
         verifyfmod(ClockSinks[EFMODSystemContext::Auditioning]->LastResult);
@@ -802,6 +1098,16 @@ bool FFMODStudioModule::Tick(float DeltaTime)
         SET_MEMORY_STAT(STAT_FMOD_Current_Memory, currentAlloc);
         SET_MEMORY_STAT(STAT_FMOD_Max_Memory, maxAlloc);
 
+        const FFMODMemoryAllocator &Allocator = FFMODMemoryAllocator::Get();
+        SET_MEMORY_STAT(STAT_FMOD_Memory_Normal, Allocator.GetCurrentBytes(FFMODMemoryAllocator::Type_Normal));
+        SET_MEMORY_STAT(STAT_FMOD_Memory_StreamFile, Allocator.GetCurrentBytes(FFMODMemoryAllocator::Type_StreamFile));
+        SET_MEMORY_STAT(STAT_FMOD_Memory_StreamDecode, Allocator.GetCurrentBytes(FFMODMemoryAllocator::Type_StreamDecode));
+        SET_MEMORY_STAT(STAT_FMOD_Memory_SampleData, Allocator.GetCurrentBytes(FFMODMemoryAllocator::Type_SampleData));
+        SET_MEMORY_STAT(STAT_FMOD_Memory_DSPBuffer, Allocator.GetCurrentBytes(FFMODMemoryAllocator::Type_DSPBuffer));
+        SET_MEMORY_STAT(STAT_FMOD_Memory_Plugin, Allocator.GetCurrentBytes(FFMODMemoryAllocator::Type_Plugin));
+        SET_MEMORY_STAT(STAT_FMOD_Memory_Persistent, Allocator.GetCurrentBytes(FFMODMemoryAllocator::Type_Persistent));
+        SET_MEMORY_STAT(STAT_FMOD_Memory_PoolReserved, Allocator.GetPoolReservedBytes());
+
         int channels, realChannels;
         FMOD::System *lowlevel;
         StudioSystem[EFMODSystemContext::Runtime]->getCoreSystem(&lowlevel);
@@ -809,7 +1115,14 @@ bool FFMODStudioModule::Tick(float DeltaTime)
         SET_DWORD_STAT(STAT_FMOD_Real_Channels, realChannels);
         SET_DWORD_STAT(STAT_FMOD_Total_Channels, channels);
 
-        verifyfmod(ClockSinks[EFMODSystemContext::Runtime]->LastResult);
+        int64 SampleDataLoaded, SampleDataCached;
+        int32 ManagedBanks;
+        FFMODBankManager::Get().GetStats(SampleDataLoaded, SampleDataCached, ManagedBanks);
+        SET_MEMORY_STAT(STAT_FMOD_SampleData_Loaded, SampleDataLoaded);
+        SET_MEMORY_STAT(STAT_FMOD_SampleData_Cached, SampleDataCached);
+        SET_DWORD_STAT(STAT_FMOD_Managed_Banks, ManagedBanks);
+
+        verifyfmod(UpdateThread.IsValid() ? UpdateThread->ConsumeLastResult() : ClockSinks[EFMODSystemContext::Runtime]->LastResult);
     }
     if (ClockSinks[EFMODSystemContext::Editor].IsValid())
     {
@@ -933,9 +1246,21 @@ void FFMODStudioModule::SetListenerPosition(int ListenerIndex, UWorld *World, co
         {
             Listeners[ListenerIndex] = FFMODListener();
             ListenerCount = ListenerIndex + 1;
-            verifyfmod(System->setNumListeners(ListenerCount));
+            if (!UpdateThread.IsValid())
+            {
+                verifyfmod(System->setNumListeners(ListenerCount));
+            }
+        }
+
+        if (UpdateThread.IsValid())
+        {
+            // Handed over to the update thread in FinishSetListenerPosition
+            PendingListenerAttributes.Attributes[ListenerIndex] = Attributes;
+        }
+        else
+        {
+            verifyfmod(System->setListenerAttributes(ListenerIndex, &Attributes));
         }
-        verifyfmod(System->setListenerAttributes(ListenerIndex, &Attributes));
 
         bListenerMoved = true;
     }
@@ -952,7 +1277,16 @@ void FFMODStudioModule::FinishSetListenerPosition(int NumListeners, float DeltaS
     if (System && NumListeners < ListenerCount)
     {
         ListenerCount = NumListeners;
-        verifyfmod(System->setNumListeners(ListenerCount));
+        if (!UpdateThread.IsValid())
+        {
+            verifyfmod(System->setNumListeners(ListenerCount));
+        }
+    }
+
+    if (UpdateThread.IsValid())
+    {
+        PendingListenerAttributes.NumListeners = ListenerCount;
+        UpdateThread->PublishListenerAttributes(PendingListenerAttributes);
     }
 
     for (int i = 0; i < ListenerCount; ++i)
@@ -1053,6 +1387,14 @@ void FFMODStudioModule::FinishSetListenerPosition(int NumListeners, float DeltaS
 
 void FFMODStudioModule::RefreshSettings()
 {
+    if (bRuntimeSystemParked)
+    {
+        // Settings may change how the system is created, so start the next PIE session from scratch
+        DestroyStudioSystem(EFMODSystemContext::Runtime);
+    }
+
+    FFMODCommandBuffer::Get().SetEnabled(GetDefault<UFMODSettings>()->bUseCommandBuffer);
+
     AssetTable.Refresh();
     if (GIsEditor)
     {
@@ -1111,12 +1453,23 @@ void FFMODStudioModule::SetInPIE(bool bInPIE, bool simulating)
         // TODO: Stop sounds for the Editor system? What should happen if the user previews a sequence with transport
         // controls then starts a PIE session? What does happen?
 
-        UE_LOG(LogFMOD, Log, TEXT("Creating runtime Studio System"));
         ListenerCount = 1;
-        CreateStudioSystem(EFMODSystemContext::Runtime);
 
-        UE_LOG(LogFMOD, Log, TEXT("Loading Banks"));
-        LoadBanks(EFMODSystemContext::Runtime);
+        if (bRuntimeSystemParked)
+        {
+            UE_LOG(LogFMOD, Log, TEXT("Reusing runtime Studio System from the last PIE session"));
+            bRuntimeSystemParked = false;
+            SetSystemPaused(false);
+            ApplyPooledEvents();
+        }
+        else
+        {
+            UE_LOG(LogFMOD, Log, TEXT("Creating runtime Studio System"));
+            CreateStudioSystem(EFMODSystemContext::Runtime);
+
+            UE_LOG(LogFMOD, Log, TEXT("Loading Banks"));
+            LoadBanks(EFMODSystemContext::Runtime);
+        }
 
         const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
         flags = Settings.LoggingLevel;
@@ -1124,7 +1477,14 @@ void FFMODStudioModule::SetInPIE(bool bInPIE, bool simulating)
     else
     {
         ReverbSnapshots.Reset();
-        DestroyStudioSystem(EFMODSystemContext::Runtime);
+        if (GIsEditor && GetDefault<UFMODSettings>()->bKeepRuntimeSystemBetweenPIESessions && StudioSystem[EFMODSystemContext::Runtime])
+        {
+            ParkRuntimeSystem();
+        }
+        else
+        {
+            DestroyStudioSystem(EFMODSystemContext::Runtime);
+        }
         flags = FMOD_DEBUG_LEVEL_WARNING;
     }
 
@@ -1143,6 +1503,11 @@ UFMODEvent *FFMODStudioModule::FindEventByName(const FString &Name)
     return Cast<UFMODEvent>(Asset);
 }
 
+UFMODAsset *FFMODStudioModule::FindAssetByPath(const FSoftObjectPath &Path)
+{
+    return AssetTable.FindByPath(Path);
+}
+
 FString FFMODStudioModule::GetBankPath(const UFMODBank &Bank)
 {
     FString BankPath = AssetTable.GetBankPath(Bank);
@@ -1156,6 +1521,196 @@ FString FFMODStudioModule::GetBankPath(const UFMODBank &Bank)
     return BankPath;
 }
 
+void FFMODStudioModule::GetBanksContainingEvents(const TSet<FGuid> &EventGuids, TArray<UFMODBank *> &OutBanks)
+{
+    AssetTable.GetBanksContainingEvents(EventGuids, OutBanks);
+}
+
+TSharedRef<FFMODBankLoadRequest> FFMODStudioModule::LoadBanksAsync(const TArray<UFMODBank *> &Banks, bool bLoadSampleData)
+{
+    TSharedRef<FFMODBankLoadRequest> Request = MakeShared<FFMODBankLoadRequest>();
+    Request->bLoadSampleData = bLoadSampleData;
+
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    FMOD::Studio::System *System = GetStudioSystem(EFMODSystemContext::Runtime);
+
+    // Loading a bank that is still in flight again would fail with FMOD_ERR_EVENT_ALREADY_LOADED
+    auto FindPendingBank = [](const FFMODBankLoadRequest &PendingRequest, const FString &Path) -> FMOD::Studio::Bank * {
+        for (const FFMODBankLoadRequest::FEntry &PendingEntry : PendingRequest.Entries)
+        {
+            if (PendingEntry.Bank && !PendingEntry.bFailed && PendingEntry.Path == Path)
+            {
+                return PendingEntry.Bank;
+            }
+        }
+        return nullptr;
+    };
+
+    for (UFMODBank *Bank : Banks)
+    {
+        if (!IsValid(Bank))
+        {
+            continue;
+        }
+
+        FFMODBankLoadRequest::FEntry &Entry = Request->Entries.AddDefaulted_GetRef();
+        Entry.Path = GetBankPath(*Bank);
+        Entry.Bank = nullptr;
+        Entry.bBankLoaded = false;
+        Entry.bSampleDataLoaded = false;
+        Entry.bFailed = false;
+
+        if (!System || Entry.Path.IsEmpty())
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Cannot load bank '%s' asynchronously: %s"), *Bank->GetName(),
+                System ? TEXT("no bank file found") : TEXT("runtime system not created"));
+            Entry.bFailed = true;
+            continue;
+        }
+
+        // Already loaded at startup, by LoadBank or by the bank manager, only the sample data may still be needed
+        FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Bank->AssetGuid);
+        if (System->getBankByID(&Guid, &Entry.Bank) == FMOD_OK && Entry.Bank)
+        {
+            continue;
+        }
+        Entry.Bank = nullptr;
+
+        Entry.Bank = FindPendingBank(*Request, Entry.Path);
+        for (int32 i = 0; Entry.Bank == nullptr && i < BankLoadRequests.Num(); ++i)
+        {
+            Entry.Bank = FindPendingBank(*BankLoadRequests[i], Entry.Path);
+        }
+        if (Entry.Bank)
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT("Bank is already loading asynchronously: %s"), *Entry.Path);
+            continue;
+        }
+
+        UE_LOG(LogFMOD, Verbose, TEXT("Loading bank asynchronously: %s"), *Entry.Path);
+
+        FMOD_RESULT Result = FMODLoadBankFile(System, Entry.Path, FMOD_STUDIO_LOAD_BANK_NONBLOCKING, &Entry.Bank, Settings.bMemoryMapBanks);
+        if (Result != FMOD_OK)
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to load bank '%s': %s"), *Entry.Path, UTF8_TO_TCHAR(FMOD_ErrorString(Result)));
+            Entry.Bank = nullptr;
+            Entry.bFailed = true;
+        }
+    }
+
+    // Delegates are only broadcast from Tick, so callers can bind to them after this returns
+    BankLoadRequests.Add(Request);
+
+    return Request;
+}
+
+void FFMODStudioModule::UpdateBankLoadRequests()
+{
+    for (int32 RequestIndex = BankLoadRequests.Num() - 1; RequestIndex >= 0; --RequestIndex)
+    {
+        // Hold a reference so the request survives listeners dropping theirs during the broadcast
+        TSharedRef<FFMODBankLoadRequest> Request = BankLoadRequests[RequestIndex];
+        const int32 PreviousSteps = Request->CompletedSteps;
+        bool bPending = false;
+
+        for (FFMODBankLoadRequest::FEntry &Entry : Request->Entries)
+        {
+            if (Entry.bFailed)
+            {
+                continue;
+            }
+
+            if (!Entry.bBankLoaded)
+            {
+                FMOD_STUDIO_LOADING_STATE State = FMOD_STUDIO_LOADING_STATE_ERROR;
+                Entry.Bank->getLoadingState(&State);
+
+                if (State == FMOD_STUDIO_LOADING_STATE_LOADED)
+                {
+                    Entry.bBankLoaded = true;
+                    Request->CompletedSteps++;
+                    StudioHandleGeneration.Increment();
+
+                    if (Request->bLoadSampleData)
+                    {
+                        verifyfmod(Entry.Bank->loadSampleData());
+                    }
+                }
+                else if (State == FMOD_STUDIO_LOADING_STATE_ERROR)
+                {
+                    UE_LOG(LogFMOD, Warning, TEXT("Failed to load bank asynchronously: %s"), *Entry.Path);
+                    Entry.Bank->unload();
+                    Entry.Bank = nullptr;
+                    Entry.bFailed = true;
+                    continue;
+                }
+                else
+                {
+                    bPending = true;
+                    continue;
+                }
+            }
+
+            if (Request->bLoadSampleData && !Entry.bSampleDataLoaded)
+            {
+                FMOD_STUDIO_LOADING_STATE State = FMOD_STUDIO_LOADING_STATE_ERROR;
+                Entry.Bank->getSampleLoadingState(&State);
+
+                if (State == FMOD_STUDIO_LOADING_STATE_LOADED)
+                {
+                    Entry.bSampleDataLoaded = true;
+                    Request->CompletedSteps++;
+                }
+                else if (State == FMOD_STUDIO_LOADING_STATE_ERROR)
+                {
+                    UE_LOG(LogFMOD, Warning, TEXT("Failed to load sample data asynchronously: %s"), *Entry.Path);
+                    Entry.bFailed = true;
+                }
+                else
+                {
+                    // Still unloaded until the queued loadSampleData command has run
+                    bPending = true;
+                }
+            }
+        }
+
+        if (!bPending)
+        {
+            bool bSucceeded = true;
+            for (const FFMODBankLoadRequest::FEntry &Entry : Request->Entries)
+            {
+                bSucceeded &= !Entry.bFailed;
+            }
+
+            // Failed entries count as finished so progress always reaches one
+            Request->CompletedSteps = Request->Entries.Num() * (Request->bLoadSampleData ? 2 : 1);
+            Request->bDone = true;
+            Request->bSucceeded = bSucceeded;
+            BankLoadRequests.RemoveAt(RequestIndex);
+
+            Request->OnProgress.Broadcast(Request->GetProgress());
+            Request->OnCompleted.Broadcast(bSucceeded);
+        }
+        else if (Request->CompletedSteps != PreviousSteps)
+        {
+            Request->OnProgress.Broadcast(Request->GetProgress());
+        }
+    }
+}
+
+void FFMODStudioModule::FailBankLoadRequests()
+{
+    TArray<TSharedRef<FFMODBankLoadRequest>> Requests = MoveTemp(BankLoadRequests);
+
+    for (TSharedRef<FFMODBankLoadRequest> &Request : Requests)
+    {
+        // The banks themselves are released along with the system
+        Request->bDone = true;
+        Request->bSucceeded = false;
+        Request->OnCompleted.Broadcast(false);
+    }
+}
+
 void FFMODStudioModule::GetAllBankPaths(TArray<FString> &Paths, bool IncludeMasterBank) const
 {
     AssetTable.GetAllBankPaths(Paths, IncludeMasterBank);
@@ -1163,6 +1718,13 @@ void FFMODStudioModule::GetAllBankPaths(TArray<FString> &Paths, bool IncludeMast
 
 void FFMODStudioModule::SetSystemPaused(bool paused)
 {
+    if (bAsyncInitPending)
+    {
+        // The runtime system is still being initialized on another thread, apply this once it's ready
+        bPauseRequested = paused;
+        return;
+    }
+
     if (StudioSystem[EFMODSystemContext::Runtime])
     {
         if (bMixerPaused != paused)
@@ -1198,6 +1760,21 @@ void FFMODStudioModule::ShutdownModule()
 {
     UE_LOG(LogFMOD, Verbose, TEXT("FFMODStudioModule shutdown"));
 
+    FFMODLevelPreloader::Get().Shutdown();
+
+    if (bAsyncInitPending)
+    {
+        // Let the background initialization finish so the runtime system can be released normally
+        AsyncInitResult.Wait();
+        bAsyncInitPending = false;
+        ReadyCallbacks.Reset();
+    }
+
+    for (int i = 0; i < EFMODSystemContext::Max; ++i)
+    {
+        bCreateOnDemand[i] = false;
+    }
+
     DestroyStudioSystem(EFMODSystemContext::Auditioning);
     DestroyStudioSystem(EFMODSystemContext::Runtime);
     DestroyStudioSystem(EFMODSystemContext::Editor);
@@ -1209,6 +1786,8 @@ void FFMODStudioModule::ShutdownModule()
 
     if (MemPool)
         FMemory::Free(MemPool);
+    else
+        FFMODMemoryAllocator::Get().Shutdown();
 
     if (GIsEditor)
     {
@@ -1255,7 +1834,7 @@ struct NamedBankEntry
 
 bool FFMODStudioModule::AreBanksLoaded()
 {
-    return bBanksLoaded;
+    return bBanksLoaded && !bAsyncInitPending;
 }
 
 bool FFMODStudioModule::SetLocale(const FString& LocaleName)
@@ -1280,6 +1859,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
     const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
 
     FailedBankLoads[Type].Reset();
+    LoadedBanks[Type].Reset();
     if (Type == EFMODSystemContext::Auditioning || Type == EFMODSystemContext::Editor)
     {
         RequiredPlugins.Reset();
@@ -1312,7 +1892,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
         {
             FString MasterBankPath = Settings.GetFullBankPath() / AssetTable.GetMasterBankPath();
             UE_LOG(LogFMOD, Verbose, TEXT("Loading master bank: %s"), *MasterBankPath);
-            Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*MasterBankPath), BankFlags, &MasterBank);
+            Result = FMODLoadBankFile(StudioSystem[Type], MasterBankPath, BankFlags, &MasterBank, Settings.bMemoryMapBanks);
             BankEntries.Add(NamedBankEntry(MasterBankPath, MasterBank, Result));
         }
 
@@ -1322,7 +1902,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
             FString MasterAssetsBankPath = Settings.GetFullBankPath() / AssetTable.GetMasterAssetsBankPath();
             if (FPaths::FileExists(MasterAssetsBankPath))
             {
-                Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*MasterAssetsBankPath), BankFlags, &MasterAssetsBank);
+                Result = FMODLoadBankFile(StudioSystem[Type], MasterAssetsBankPath, BankFlags, &MasterAssetsBank, Settings.bMemoryMapBanks);
                 BankEntries.Add(NamedBankEntry(MasterAssetsBankPath, MasterAssetsBank, Result));
             }
         }
@@ -1336,7 +1916,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
                 FString StringsBankPath = Settings.GetFullBankPath() / AssetTable.GetMasterStringsBankPath();
                 UE_LOG(LogFMOD, Verbose, TEXT("Loading strings bank: %s"), *StringsBankPath);
                 FMOD::Studio::Bank *StringsBank = nullptr;
-                Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*StringsBankPath), BankFlags, &StringsBank);
+                Result = FMODLoadBankFile(StudioSystem[Type], StringsBankPath, BankFlags, &StringsBank, Settings.bMemoryMapBanks);
                 BankEntries.Add(NamedBankEntry(StringsBankPath, StringsBank, Result));
             }
 
@@ -1356,7 +1936,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
                     UE_LOG(LogFMOD, Log, TEXT("Loading bank: %s"), *OtherFile);
 
                     FMOD::Studio::Bank *OtherBank;
-                    Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*OtherFile), BankFlags, &OtherBank);
+                    Result = FMODLoadBankFile(StudioSystem[Type], OtherFile, BankFlags, &OtherBank, Settings.bMemoryMapBanks);
                     BankEntries.Add(NamedBankEntry(OtherFile, OtherBank, Result));
                 }
             }
@@ -1400,7 +1980,11 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
                     verifyfmod(Entry.Bank->loadSampleData());
                 }
             }
-            if (Entry.Bank == nullptr || Entry.Result != FMOD_OK)
+            if (Entry.Bank != nullptr && Entry.Result == FMOD_OK)
+            {
+                LoadedBanks[Type].Add(Entry.Name, Entry.Bank);
+            }
+            else
             {
                 FString ErrorMessage;
                 if (!FPaths::FileExists(Entry.Name))
@@ -1415,27 +1999,392 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
                 FailedBankLoads[Type].Add(FString::Printf(TEXT("%s (%s)"), *FPaths::GetBaseFilename(Entry.Name), *ErrorMessage));
             }
         }
+
+        // Looks up event assets, so when initializing in the background this waits for FinishAsyncInitialization
+        if (Type == EFMODSystemContext::Runtime && !bAsyncInitPending)
+        {
+            ApplyPooledEvents();
+        }
     }
 
+    // Loading banks can replace events, buses and VCAs, so drop any handles cached before
+    StudioHandleGeneration.Increment();
     bBanksLoaded = true;
 }
 
+void FFMODStudioModule::ParkRuntimeSystem()
+{
+    UE_LOG(LogFMOD, Log, TEXT("Keeping runtime Studio System for the next PIE session"));
+
+    FMOD::Studio::System *System = StudioSystem[EFMODSystemContext::Runtime];
+
+    FFMODCommandBuffer::Get().Flush();
+    FailBankLoadRequests();
+    FFMODInstancePool::Get().Reset();
+    FFMODPlaybackCompletionQueue::Get().Reset();
+    FFMODSignificanceManager::Get().Reset(false);
+    FFMODOcclusionManager::Get().Reset();
+    // The system is kept, so sample data loaded for the session has to be released rather than forgotten
+    FFMODLevelPreloader::Get().Reset(true);
+    FFMODBankManager::Get().Reset(true);
+
+    // Stopping every instance includes snapshots
+    ReleaseAllInstances(System);
+
+    // Unload anything the session loaded on top of the startup banks
+    TArray<FMOD::Studio::Bank *> StartupBanks;
+    LoadedBanks[EFMODSystemContext::Runtime].GenerateValueArray(StartupBanks);
+
+    int BankCount = 0;
+    verifyfmod(System->getBankCount(&BankCount));
+    if (BankCount > 0)
+    {
+        TArray<FMOD::Studio::Bank *> Banks;
+        Banks.SetNumUninitialized(BankCount);
+        verifyfmod(System->getBankList(Banks.GetData(), BankCount, &BankCount));
+
+        for (int i = 0; i < BankCount; ++i)
+        {
+            if (!StartupBanks.Contains(Banks[i]))
+            {
+                verifyfmod(Banks[i]->unload());
+            }
+        }
+    }
+
+    // Buses and VCAs go back to the state they are loaded with
+    for (FMOD::Studio::Bank *Bank : StartupBanks)
+    {
+        int BusCount = 0;
+        if (Bank->getBusCount(&BusCount) == FMOD_OK && BusCount > 0)
+        {
+            TArray<FMOD::Studio::Bus *> Buses;
+            Buses.SetNumUninitialized(BusCount);
+            verifyfmod(Bank->getBusList(Buses.GetData(), BusCount, &BusCount));
+            for (int i = 0; i < BusCount; ++i)
+            {
+                verifyfmod(Buses[i]->setVolume(1.0f));
+                verifyfmod(Buses[i]->setPaused(false));
+                verifyfmod(Buses[i]->setMute(false));
+            }
+        }
+
+        int VCACount = 0;
+        if (Bank->getVCACount(&VCACount) == FMOD_OK && VCACount > 0)
+        {
+            TArray<FMOD::Studio::VCA *> VCAs;
+            VCAs.SetNumUninitialized(VCACount);
+            verifyfmod(Bank->getVCAList(VCAs.GetData(), VCACount, &VCACount));
+            for (int i = 0; i < VCACount; ++i)
+            {
+                verifyfmod(VCAs[i]->setVolume(1.0f));
+            }
+        }
+    }
+
+    // Global parameters go back to their defaults
+    int ParameterCount = 0;
+    verifyfmod(System->getParameterDescriptionCount(&ParameterCount));
+    if (ParameterCount > 0)
+    {
+        TArray<FMOD_STUDIO_PARAMETER_DESCRIPTION> Parameters;
+        Parameters.SetNumUninitialized(ParameterCount);
+        verifyfmod(System->getParameterDescriptionList(Parameters.GetData(), ParameterCount, &ParameterCount));
+        for (int i = 0; i < ParameterCount; ++i)
+        {
+            if (!(Parameters[i].flags & FMOD_STUDIO_PARAMETER_READONLY))
+            {
+                verifyfmod(System->setParameterByID(Parameters[i].id, Parameters[i].defaultvalue, true));
+            }
+        }
+    }
+
+    // Listeners start from a single default listener, as on a new system
+    ListenerCount = 1;
+    ResetInterpolation();
+    FMOD_3D_ATTRIBUTES ListenerAttributes = { { 0 } };
+    ListenerAttributes.forward.z = 1.0f;
+    ListenerAttributes.up.y = 1.0f;
+    if (UpdateThread.IsValid())
+    {
+        PendingListenerAttributes = FFMODListenerAttributes();
+        PendingListenerAttributes.Attributes[0] = ListenerAttributes;
+        UpdateThread->PublishListenerAttributes(PendingListenerAttributes);
+    }
+    else
+    {
+        verifyfmod(System->setNumListeners(1));
+        verifyfmod(System->setListenerAttributes(0, &ListenerAttributes));
+    }
+
+    verifyfmod(System->flushCommands());
+
+    // Keep the mixer quiet until the next session
+    SetSystemPaused(true);
+    bRuntimeSystemParked = true;
+}
+
+void FFMODStudioModule::ApplyPooledEvents()
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+
+    for (const FFMODPooledEvent &PooledEvent : Settings.PooledEvents)
+    {
+        UFMODEvent *Event = Cast<UFMODEvent>(FindAssetByPath(PooledEvent.Event));
+        if (Event == nullptr)
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Pooled event not found: %s"), *PooledEvent.Event.ToString());
+            continue;
+        }
+        Event->bPoolInstances = true;
+        Event->PoolPrewarmSize = PooledEvent.PrewarmSize;
+
+        FMOD::Studio::EventDescription *EventDesc = GetEventDescription(Event, EFMODSystemContext::Runtime);
+        if (EventDesc != nullptr)
+        {
+            FFMODInstancePool::Get().Prewarm(EventDesc, PooledEvent.PrewarmSize);
+        }
+    }
+}
+
+void FFMODStudioModule::StartAsyncInitialization()
+{
+    UE_LOG(LogFMOD, Log, TEXT("Creating runtime Studio System in the background"));
+
+    bIsInPIE = true;
+    bSimulating = false;
+    bListenerMoved = true;
+    ResetInterpolation();
+    ListenerCount = 1;
+
+    if (!bUseSound)
+    {
+        return;
+    }
+
+    bAsyncInitPending = true;
+    bPauseRequested = false;
+    AsyncInitResult = Async(EAsyncExecution::Thread, [this]() {
+        InitializeStudioSystem(EFMODSystemContext::Runtime);
+        LoadBanks(EFMODSystemContext::Runtime);
+    });
+}
+
+void FFMODStudioModule::FinishAsyncInitialization()
+{
+    check(IsInGameThread());
+
+    AsyncInitResult.Wait();
+    AsyncInitResult = TFuture<void>();
+
+    RegisterStudioSystem(EFMODSystemContext::Runtime);
+
+    bAsyncInitPending = false;
+    ApplyPooledEvents();
+    SetSystemPaused(bPauseRequested);
+
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    verifyfmod(FMOD::Debug_Initialize(Settings.LoggingLevel, FMOD_DEBUG_MODE_CALLBACK, FMODLogCallback));
+
+    UE_LOG(LogFMOD, Log, TEXT("Runtime Studio System ready, running %d queued requests"), ReadyCallbacks.Num());
+
+    TArray<TFunction<void()>> Callbacks = MoveTemp(ReadyCallbacks);
+    for (TFunction<void()> &Callback : Callbacks)
+    {
+        Callback();
+    }
+}
+
+void FFMODStudioModule::QueueUntilReady(TFunction<void()> Callback)
+{
+    check(IsInGameThread());
+
+    if (bAsyncInitPending)
+    {
+        ReadyCallbacks.Add(MoveTemp(Callback));
+    }
+    else
+    {
+        Callback();
+    }
+}
+
+static void GetBankEventGuids(FMOD::Studio::Bank *Bank, TArray<FGuid> &OutGuids)
+{
+    int EventCount = 0;
+    if (Bank->getEventCount(&EventCount) != FMOD_OK || EventCount == 0)
+    {
+        return;
+    }
+
+    TArray<FMOD::Studio::EventDescription *> EventList;
+    EventList.AddZeroed(EventCount);
+    verifyfmod(Bank->getEventList(EventList.GetData(), EventCount, &EventCount));
+    for (int EventIdx = 0; EventIdx < EventCount; ++EventIdx)
+    {
+        FMOD::Studio::ID Guid = { 0 };
+        if (EventList[EventIdx]->getID(&Guid) == FMOD_OK)
+        {
+            OutGuids.AddUnique(FMODUtils::ConvertGuid(Guid));
+        }
+    }
+}
+
+void FFMODStudioModule::ReloadChangedBanks(EFMODSystemContext::Type Type, const TArray<FString> &ChangedBanks, FFMODBankChanges &Changes)
+{
+    if (StudioSystem[Type] == nullptr || ChangedBanks.Num() == 0)
+    {
+        return;
+    }
+
+    UE_LOG(LogFMOD, Verbose, TEXT("Reloading %d changed banks for context %s"), ChangedBanks.Num(), FMODSystemContextNames[Type]);
+
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    FString BankDir = Settings.GetFullBankPath();
+
+    // Only banks for the active locale are loaded, along with the master banks
+    TArray<FString> WantedBankPaths;
+    AssetTable.GetAllBankPaths(WantedBankPaths, true);
+    WantedBankPaths.Add(BankDir / AssetTable.GetMasterStringsBankPath());
+
+    // Forget earlier failures for the banks being reloaded, failures of other banks still stand
+    for (const FString &ChangedBank : ChangedBanks)
+    {
+        const FString FailurePrefix = FPaths::GetBaseFilename(ChangedBank) + TEXT(" (");
+        FailedBankLoads[Type].RemoveAll([&FailurePrefix](const FString &Failure) { return Failure.StartsWith(FailurePrefix); });
+    }
+
+    // Same rules as LoadBanks, so the reloaded system matches one that was created from scratch
+    const bool bLoadAllBanks = (Type == EFMODSystemContext::Auditioning) || (Type == EFMODSystemContext::Editor) || Settings.bLoadAllBanks;
+    const bool bLoadSampleData = (Type == EFMODSystemContext::Runtime) && Settings.bLoadAllSampleData;
+
+    // Unload the old versions first, FMOD won't load a bank whose guid is already loaded
+    TArray<FString> PreviouslyLoaded;
+    for (const FString &ChangedBank : ChangedBanks)
+    {
+        FMOD::Studio::Bank *Bank = nullptr;
+        if (LoadedBanks[Type].RemoveAndCopyValue(BankDir / ChangedBank, Bank))
+        {
+            PreviouslyLoaded.Add(BankDir / ChangedBank);
+            GetBankEventGuids(Bank, Changes.ChangedEvents);
+            verifyfmod(Bank->unload());
+        }
+    }
+    verifyfmod(StudioSystem[Type]->flushCommands());
+
+    TArray<NamedBankEntry> BankEntries;
+    for (const FString &ChangedBank : ChangedBanks)
+    {
+        FString BankPath = BankDir / ChangedBank;
+        if (!WantedBankPaths.Contains(BankPath) || !FPaths::FileExists(BankPath))
+        {
+            continue;
+        }
+        if (!bLoadAllBanks && !PreviouslyLoaded.Contains(BankPath))
+        {
+            // Only the master banks are loaded up front, anything else is left for the game to load
+            continue;
+        }
+        if (Settings.SkipLoadBankName.Len() && BankPath.Contains(Settings.SkipLoadBankName))
+        {
+            UE_LOG(LogFMOD, Log, TEXT("Skipping bank: %s"), *BankPath);
+            continue;
+        }
+        UE_LOG(LogFMOD, Log, TEXT("Reloading bank: %s"), *BankPath);
+
+        FMOD::Studio::Bank *Bank = nullptr;
+        FMOD_RESULT Result = FMODLoadBankFile(StudioSystem[Type], BankPath, FMOD_STUDIO_LOAD_BANK_NONBLOCKING, &Bank, Settings.bMemoryMapBanks);
+        BankEntries.Add(NamedBankEntry(BankPath, Bank, Result));
+    }
+
+    // Wait for all banks to load.
+    verifyfmod(StudioSystem[Type]->flushCommands());
+
+    for (NamedBankEntry &Entry : BankEntries)
+    {
+        if (Entry.Result == FMOD_OK)
+        {
+            FMOD_STUDIO_LOADING_STATE BankLoadingState = FMOD_STUDIO_LOADING_STATE_ERROR;
+            Entry.Result = Entry.Bank->getLoadingState(&BankLoadingState);
+            if (BankLoadingState == FMOD_STUDIO_LOADING_STATE_ERROR)
+            {
+                Entry.Bank->unload();
+                Entry.Bank = nullptr;
+            }
+            else if (bLoadSampleData)
+            {
+                verifyfmod(Entry.Bank->loadSampleData());
+            }
+        }
+        if (Entry.Bank != nullptr && Entry.Result == FMOD_OK)
+        {
+            LoadedBanks[Type].Add(Entry.Name, Entry.Bank);
+            GetBankEventGuids(Entry.Bank, Changes.ChangedEvents);
+        }
+        else
+        {
+            FString ErrorMessage = UTF8_TO_TCHAR(FMOD_ErrorString(Entry.Result));
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to load bank: %s (%s)"), *Entry.Name, *ErrorMessage);
+            FailedBankLoads[Type].Add(FString::Printf(TEXT("%s (%s)"), *FPaths::GetBaseFilename(Entry.Name), *ErrorMessage));
+        }
+    }
+}
+
 void FFMODStudioModule::HandleBanksUpdated()
 {
     UE_LOG(LogFMOD, Verbose, TEXT("Refreshing auditioning system"));
 
-    DestroyStudioSystem(EFMODSystemContext::Auditioning);
-
     AssetTable.Refresh();
 
-    CreateStudioSystem(EFMODSystemContext::Auditioning);
-    LoadBanks(EFMODSystemContext::Auditioning);
+    FFMODBankChanges Changes;
+    AssetTable.GetAssetChanges(Changes.AddedAssets, Changes.RemovedAssets);
 
-    DestroyStudioSystem(EFMODSystemContext::Editor);
-    CreateStudioSystem(EFMODSystemContext::Editor);
-    LoadBanks(EFMODSystemContext::Editor);
+    // Only banks whose contents actually changed need reloading, unless the mixer itself changed
+    const bool bCanReloadIncrementally = AssetTable.GetChangedBankFiles(Changes.ChangedBanks) &&
+                                         !Changes.ChangedBanks.Contains(AssetTable.GetMasterBankPath()) &&
+                                         !Changes.ChangedBanks.Contains(AssetTable.GetMasterAssetsBankPath());
+
+    Changes.bFullReload = !bCanReloadIncrementally;
+    if (!bCanReloadIncrementally || Changes.ChangedBanks.Num() > 0)
+    {
+        StopAuditioningInstance();
+    }
 
-    BanksReloadedDelegate.Broadcast();
+    if (bRuntimeSystemParked)
+    {
+        if (bCanReloadIncrementally && LoadedBanks[EFMODSystemContext::Runtime].Num() > 0)
+        {
+            ReloadChangedBanks(EFMODSystemContext::Runtime, Changes.ChangedBanks, Changes);
+        }
+        else
+        {
+            DestroyStudioSystem(EFMODSystemContext::Runtime);
+        }
+    }
+
+    // Systems that haven't been created yet will load the new banks when they are
+    for (EFMODSystemContext::Type Type : { EFMODSystemContext::Auditioning, EFMODSystemContext::Editor })
+    {
+        if (!StudioSystem[Type])
+        {
+            continue;
+        }
+
+        // A system that has no banks yet, such as one created before the first notification, needs everything loaded
+        if (bCanReloadIncrementally && LoadedBanks[Type].Num() > 0)
+        {
+            ReloadChangedBanks(Type, Changes.ChangedBanks, Changes);
+        }
+        else
+        {
+            DestroyStudioSystem(Type);
+            CreateStudioSystem(Type);
+            LoadBanks(Type);
+            Changes.bFullReload = true;
+        }
+    }
+
+    BanksReloadedDelegate.Broadcast(Changes);
 }
 
 FMOD::Studio::System *FFMODStudioModule::GetStudioSystem(EFMODSystemContext::Type Context)
@@ -1444,25 +2393,83 @@ FMOD::Studio::System *FFMODStudioModule::GetStudioSystem(EFMODSystemContext::Typ
     {
         Context = (bIsInPIE ? EFMODSystemContext::Runtime : EFMODSystemContext::Auditioning);
     }
+    if (Context == EFMODSystemContext::Runtime && (bAsyncInitPending || bRuntimeSystemParked))
+    {
+        // Still being created in the background, or waiting for the next PIE session
+        return nullptr;
+    }
+    if (StudioSystem[Context] == nullptr && bCreateOnDemand[Context] && IsInGameThread())
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("Creating %s system on first use"), FMODSystemContextNames[Context]);
+        CreateStudioSystem(Context);
+        LoadBanks(Context);
+    }
     return StudioSystem[Context];
 }
 
+bool FFMODStudioModule::HasStudioSystem(EFMODSystemContext::Type Context)
+{
+    return Context < EFMODSystemContext::Max && StudioSystem[Context] != nullptr;
+}
+
 FMOD::Studio::EventDescription *FFMODStudioModule::GetEventDescription(const UFMODEvent *Event, EFMODSystemContext::Type Context)
 {
     if (Context == EFMODSystemContext::Max)
     {
         Context = (bIsInPIE ? EFMODSystemContext::Runtime : EFMODSystemContext::Auditioning);
     }
-    if (StudioSystem[Context] != nullptr && IsValid(Event) && Event->AssetGuid.IsValid())
+    if (GetStudioSystem(Context) != nullptr && IsValid(Event) && Event->AssetGuid.IsValid())
     {
-        FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Event->AssetGuid);
-        FMOD::Studio::EventDescription *EventDesc = nullptr;
-        StudioSystem[Context]->getEventByID(&Guid, &EventDesc);
+        FMOD::Studio::EventDescription *EventDesc = FindCachedHandle<FMOD::Studio::EventDescription>(Event, Context);
+        if (EventDesc == nullptr)
+        {
+            FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Event->AssetGuid);
+            if (StudioSystem[Context]->getEventByID(&Guid, &EventDesc) == FMOD_OK)
+            {
+                StoreCachedHandle(Event, Context, EventDesc);
+            }
+        }
         return EventDesc;
     }
     return nullptr;
 }
 
+FMOD::Studio::Bus *FFMODStudioModule::GetBus(const UFMODBus *Bus, EFMODSystemContext::Type Context)
+{
+    if (GetStudioSystem(Context) != nullptr && IsValid(Bus) && Bus->AssetGuid.IsValid())
+    {
+        FMOD::Studio::Bus *StudioBus = FindCachedHandle<FMOD::Studio::Bus>(Bus, Context);
+        if (StudioBus == nullptr)
+        {
+            FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Bus->AssetGuid);
+            if (StudioSystem[Context]->getBusByID(&Guid, &StudioBus) == FMOD_OK)
+            {
+                StoreCachedHandle(Bus, Context, StudioBus);
+            }
+        }
+        return StudioBus;
+    }
+    return nullptr;
+}
+
+FMOD::Studio::VCA *FFMODStudioModule::GetVCA(const UFMODVCA *Vca, EFMODSystemContext::Type Context)
+{
+    if (GetStudioSystem(Context) != nullptr && IsValid(Vca) && Vca->AssetGuid.IsValid())
+    {
+        FMOD::Studio::VCA *StudioVCA = FindCachedHandle<FMOD::Studio::VCA>(Vca, Context);
+        if (StudioVCA == nullptr)
+        {
+            FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Vca->AssetGuid);
+            if (StudioSystem[Context]->getVCAByID(&Guid, &StudioVCA) == FMOD_OK)
+            {
+                StoreCachedHandle(Vca, Context, StudioVCA);
+            }
+        }
+        return StudioVCA;
+    }
+    return nullptr;
+}
+
 FMOD::Studio::EventInstance *FFMODStudioModule::CreateAuditioningInstance(const UFMODEvent *Event)
 {
     StopAuditioningInstance();
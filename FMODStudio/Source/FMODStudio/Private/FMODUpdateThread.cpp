@@ -0,0 +1,103 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODUpdateThread.h"
+#include "FMODStudioPrivatePCH.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+
+FFMODUpdateThread::FFMODUpdateThread(FMOD::Studio::System *InSystem, float InUpdateRate)
+    : System(InSystem)
+    , UpdatePeriod(1.0f / FMath::Max(InUpdateRate, 1.0f))
+    , Thread(nullptr)
+    , WakeEvent(nullptr)
+    , LastResult(FMOD_OK)
+    , WriteSlot(0)
+    , ReadSlot(1)
+    , SharedSlot(2)
+    , AppliedNumListeners(1)
+{
+    WakeEvent = FGenericPlatformProcess::GetSynchEventFromPool();
+    Thread = FRunnableThread::Create(this, TEXT("FMOD Studio Update"), 0, TPri_AboveNormal);
+}
+
+FFMODUpdateThread::~FFMODUpdateThread()
+{
+    if (Thread)
+    {
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    FGenericPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    WakeEvent = nullptr;
+}
+
+void FFMODUpdateThread::PublishListenerAttributes(const FFMODListenerAttributes &InAttributes)
+{
+    Slots[WriteSlot] = InAttributes;
+
+    // Hand the freshly written slot over and take back whichever slot was shared
+    int32 Previous = FPlatformAtomics::InterlockedExchange(&SharedSlot, WriteSlot | DirtyFlag);
+    WriteSlot = Previous & SlotMask;
+}
+
+FMOD_RESULT FFMODUpdateThread::ConsumeLastResult()
+{
+    return (FMOD_RESULT)LastResult.Set(FMOD_OK);
+}
+
+void FFMODUpdateThread::ApplyListenerAttributes()
+{
+    if ((FPlatformAtomics::AtomicRead(&SharedSlot) & DirtyFlag) == 0)
+    {
+        return;
+    }
+
+    int32 Previous = FPlatformAtomics::InterlockedExchange(&SharedSlot, ReadSlot);
+    ReadSlot = Previous & SlotMask;
+
+    const FFMODListenerAttributes &Attributes = Slots[ReadSlot];
+    if (Attributes.NumListeners != AppliedNumListeners)
+    {
+        AppliedNumListeners = Attributes.NumListeners;
+        System->setNumListeners(AppliedNumListeners);
+    }
+    for (int32 i = 0; i < Attributes.NumListeners; ++i)
+    {
+        System->setListenerAttributes(i, &Attributes.Attributes[i]);
+    }
+}
+
+uint32 FFMODUpdateThread::Run()
+{
+    while (!bStopping)
+    {
+        double StartTime = FPlatformTime::Seconds();
+
+        ApplyListenerAttributes();
+
+        FMOD_RESULT Result = System->update();
+        if (Result != FMOD_OK)
+        {
+            LastResult.Set(Result);
+        }
+
+        double Remaining = UpdatePeriod - (FPlatformTime::Seconds() - StartTime);
+        if (Remaining > 0.0)
+        {
+            WakeEvent->Wait(FTimespan::FromSeconds(Remaining));
+        }
+    }
+
+    return 0;
+}
+
+void FFMODUpdateThread::Stop()
+{
+    bStopping = true;
+    WakeEvent->Trigger();
+}
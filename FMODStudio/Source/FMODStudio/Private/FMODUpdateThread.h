@@ -0,0 +1,65 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "fmod_studio.hpp"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+
+class FRunnableThread;
+class FEvent;
+
+/** Listener state handed from the game thread to the update thread */
+struct FFMODListenerAttributes
+{
+    FFMODListenerAttributes()
+        : NumListeners(1)
+    {
+        FMemory::Memzero(Attributes);
+    }
+
+    int32 NumListeners;
+    FMOD_3D_ATTRIBUTES Attributes[FMOD_MAX_LISTENERS];
+};
+
+/**
+ * Calls Studio::System::update at a fixed rate on its own thread, so that audio is not tied to the game frame rate.
+ * Listener attributes are published by the game thread through a lock free triple buffer and applied before each update.
+ */
+class FFMODUpdateThread : public FRunnable
+{
+public:
+    FFMODUpdateThread(FMOD::Studio::System *InSystem, float InUpdateRate);
+    virtual ~FFMODUpdateThread();
+
+    /** Publish the latest listener attributes.  Must only be called from the game thread. */
+    void PublishListenerAttributes(const FFMODListenerAttributes &InAttributes);
+
+    /** Returns the result of the last failed update since this was last called */
+    FMOD_RESULT ConsumeLastResult();
+
+    // FRunnable interface
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    void ApplyListenerAttributes();
+
+    FMOD::Studio::System *System;
+    float UpdatePeriod;
+    FRunnableThread *Thread;
+    FEvent *WakeEvent;
+    FThreadSafeBool bStopping;
+    FThreadSafeCounter LastResult;
+
+    /** Triple buffer: the writer owns one slot, the reader owns one and the third is exchanged between them */
+    static const int32 SlotMask = 0x3;
+    static const int32 DirtyFlag = 0x4;
+    FFMODListenerAttributes Slots[3];
+    int32 WriteSlot;
+    int32 ReadSlot;
+    volatile int32 SharedSlot;
+
+    int32 AppliedNumListeners;
+};
@@ -3,20 +3,26 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "UObject/SoftObjectPath.h"
 
 namespace FMOD
 {
 namespace Studio
 {
 class System;
+class Bank;
 class EventDescription;
 class EventInstance;
+class Bus;
+class VCA;
 }
 }
 
 class UFMODAsset;
 class UFMODBank;
 class UFMODEvent;
+class UFMODBus;
+class UFMODVCA;
 class UWorld;
 class AAudioVolume;
 struct FInteriorSettings;
@@ -41,6 +47,90 @@ enum Type
 };
 }
 
+/**
+ * Describes what changed when banks were reloaded
+ */
+struct FFMODBankChanges
+{
+    FFMODBankChanges()
+        : bFullReload(true)
+    {
+    }
+
+    /** True if the Studio systems were recreated, in which case every handle is invalid */
+    bool bFullReload;
+
+    /** Bank files that were added, modified or deleted, relative to the bank output directory */
+    TArray<FString> ChangedBanks;
+
+    /** Events contained in the changed banks, before and after the reload */
+    TArray<FGuid> ChangedEvents;
+
+    /** Assets that appeared in or disappeared from the strings bank */
+    TArray<FGuid> AddedAssets;
+    TArray<FGuid> RemovedAssets;
+
+    /** Returns whether anything relating to the given asset may have changed */
+    bool AffectsAsset(const FGuid &AssetGuid) const
+    {
+        return bFullReload || ChangedEvents.Contains(AssetGuid) || AddedAssets.Contains(AssetGuid) || RemovedAssets.Contains(AssetGuid);
+    }
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FFMODBanksReloadedDelegate, const FFMODBankChanges &);
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FFMODBankLoadProgressDelegate, float /* Progress */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FFMODBankLoadCompletedDelegate, bool /* bSucceeded */);
+
+/**
+ * A set of banks being loaded in the background, started with IFMODStudioModule::LoadBanksAsync.
+ * Loading states are polled once per frame, and the delegates are broadcast on the game thread.
+ */
+class FFMODBankLoadRequest
+{
+public:
+    FFMODBankLoadRequest()
+        : bLoadSampleData(false)
+        , CompletedSteps(0)
+        , bDone(false)
+        , bSucceeded(false)
+    {
+    }
+
+    /** Fraction of the banks, and their sample data if requested, that have finished loading */
+    float GetProgress() const { return Entries.Num() > 0 ? (float)CompletedSteps / (Entries.Num() * (bLoadSampleData ? 2 : 1)) : 1.0f; }
+
+    /** Whether every bank has either finished loading or failed */
+    bool IsDone() const { return bDone; }
+
+    /** Whether every bank loaded successfully, once done */
+    bool Succeeded() const { return bSucceeded; }
+
+    /** Broadcast whenever progress changes */
+    FFMODBankLoadProgressDelegate OnProgress;
+
+    /** Broadcast once when every bank has finished loading or failed */
+    FFMODBankLoadCompletedDelegate OnCompleted;
+
+private:
+    friend class FFMODStudioModule;
+
+    struct FEntry
+    {
+        FString Path;
+        FMOD::Studio::Bank *Bank;
+        bool bBankLoaded;
+        bool bSampleDataLoaded;
+        bool bFailed;
+    };
+
+    TArray<FEntry> Entries;
+    bool bLoadSampleData;
+    int32 CompletedSteps;
+    bool bDone;
+    bool bSucceeded;
+};
+
 /**
  * The public interface to this module
  */
@@ -63,10 +153,16 @@ public:
     static inline bool IsAvailable() { return FModuleManager::Get().IsModuleLoaded("FMODStudio"); }
 
     /**
-	 * Get a pointer to the runtime studio system (only valid in-game or in PIE)
+	 * Get a pointer to the runtime studio system (only valid in-game or in PIE).
+	 * In the editor the auditioning and editor systems are created, and their banks loaded, the first time they are asked for.
 	 */
     virtual FMOD::Studio::System *GetStudioSystem(EFMODSystemContext::Type Context) = 0;
 
+    /**
+	 * Returns whether a studio system currently exists, without creating it on demand
+	 */
+    virtual bool HasStudioSystem(EFMODSystemContext::Type Context) = 0;
+
     /**
 	 * Set system paused (for PIE pause)
 	 */
@@ -92,11 +188,27 @@ public:
 	 */
     virtual UFMODEvent *FindEventByName(const FString &Name) = 0;
 
+    /**
+	 * Look up an asset given its object path, constructing it first if assets are created lazily
+	 */
+    virtual UFMODAsset *FindAssetByPath(const FSoftObjectPath &Path) = 0;
+
     /**
       * Get the disk path for a Bank asset
       */
     virtual FString GetBankPath(const UFMODBank &Bank) = 0;
 
+    /**
+	 * Get the Bank assets that contain any of the given events.  Works without any Studio system, such as while cooking.
+	 */
+    virtual void GetBanksContainingEvents(const TSet<FGuid> &EventGuids, TArray<UFMODBank *> &OutBanks) = 0;
+
+    /**
+	 * Load banks into the runtime system without blocking, optionally followed by their sample data.
+	 * Bind to the returned request's delegates to be told about progress and completion.
+	 */
+    virtual TSharedRef<FFMODBankLoadRequest> LoadBanksAsync(const TArray<UFMODBank *> &Banks, bool bLoadSampleData) = 0;
+
     /**
       * Get the disk paths for all Banks
       */
@@ -109,6 +221,16 @@ public:
     virtual FMOD::Studio::EventDescription *GetEventDescription(
         const UFMODEvent *Event, EFMODSystemContext::Type Context = EFMODSystemContext::Max) = 0;
 
+    /**
+	 * Get a bus.  Like event descriptions, the handle is cached on the asset until banks are unloaded.
+	 */
+    virtual FMOD::Studio::Bus *GetBus(const UFMODBus *Bus, EFMODSystemContext::Type Context = EFMODSystemContext::Runtime) = 0;
+
+    /**
+	 * Get a VCA.  Like event descriptions, the handle is cached on the asset until banks are unloaded.
+	 */
+    virtual FMOD::Studio::VCA *GetVCA(const UFMODVCA *Vca, EFMODSystemContext::Type Context = EFMODSystemContext::Runtime) = 0;
+
     /**
 	 * Create a single auditioning instance using the auditioning system
 	 */
@@ -139,8 +261,8 @@ public:
 	 */
     virtual const FFMODListener &GetNearestListener(const FVector &Location) = 0;
 
-    /** This event is fired after all banks were reloaded */
-    virtual FSimpleMulticastDelegate &BanksReloadedEvent() = 0;
+    /** This event is fired after banks were reloaded, with the set of banks and assets that changed */
+    virtual FFMODBanksReloadedDelegate &BanksReloadedEvent() = 0;
 
     /** Return a list of banks that failed to load due to an error */
     virtual TArray<FString> GetFailedBankLoads(EFMODSystemContext::Type Context) = 0;
@@ -163,6 +285,12 @@ public:
     /** Returns if the banks have been loaded */
     virtual bool AreBanksLoaded() = 0;
 
+    /** Returns false while the runtime system is still being created in the background */
+    virtual bool IsSystemReady() = 0;
+
+    /** Run a function on the game thread once the runtime system is ready, or straight away if it already is */
+    virtual void QueueUntilReady(TFunction<void()> Callback) = 0;
+
     /** Set active locale. Locale must be the locale name of one of the configured project locales */
     virtual bool SetLocale(const FString& Locale) = 0;
 };
@@ -134,10 +134,13 @@ void FAssetTypeActions_FMODEvent::HandleBeginPIE(bool bSimulating)
     CurrentPreviewEventInstance = nullptr;
 }
 
-void FAssetTypeActions_FMODEvent::HandleBanksReloaded()
+void FAssetTypeActions_FMODEvent::HandleBanksReloaded(const FFMODBankChanges &Changes)
 {
-    // Studio module will handle its own auditioning, just clear the handle
-    CurrentPreviewEventInstance = nullptr;
+    // Studio module will handle its own auditioning, just clear the handle if it was stopped
+    if (Changes.bFullReload || Changes.ChangedBanks.Num() > 0)
+    {
+        CurrentPreviewEventInstance = nullptr;
+    }
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -13,6 +13,7 @@ class EventInstance;
 }
 
 class UFMODEvent;
+struct FFMODBankChanges;
 
 class FAssetTypeActions_FMODEvent : public FAssetTypeActions_Base
 {
@@ -49,7 +50,7 @@ private:
     void PlayEvent(UFMODEvent *Event);
 
     void HandleBeginPIE(bool bSimulating);
-    void HandleBanksReloaded();
+    void HandleBanksReloaded(const FFMODBankChanges &Changes);
 
     FMOD::Studio::EventInstance *CurrentPreviewEventInstance;
     FDelegateHandle BeginPIEDelegateHandle;
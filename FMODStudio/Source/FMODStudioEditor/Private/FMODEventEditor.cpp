@@ -168,9 +168,18 @@ TSharedRef<SDockTab> FFMODEventEditor::SpawnTab_EventEditor(const FSpawnTabArgs
         .TabColorScale(GetTabColorScale())[FMODEventEditorPanel.ToSharedRef()];
 }
 
-void FFMODEventEditor::HandleBanksReloaded()
+void FFMODEventEditor::HandleBanksReloaded(const FFMODBankChanges &Changes)
 {
-    CurrentPreviewEventInstance = nullptr;
+    // Any bank change stops the auditioning instance
+    if (Changes.bFullReload || Changes.ChangedBanks.Num() > 0)
+    {
+        CurrentPreviewEventInstance = nullptr;
+    }
+
+    if (!IsValid(EditedEvent) || !Changes.AffectsAsset(EditedEvent->AssetGuid))
+    {
+        return;
+    }
 
     CreateInternalWidgets();
 
@@ -14,6 +14,8 @@ class EventInstance;
 }
 }
 
+struct FFMODBankChanges;
+
 static bool operator==(const FMOD_STUDIO_PARAMETER_ID &a, const FMOD_STUDIO_PARAMETER_ID &b)
 {
     return (a.data1 == b.data1 && a.data2 == b.data2);
@@ -64,7 +66,7 @@ private:
     FMOD::Studio::EventInstance *CurrentPreviewEventInstance;
 
     void HandlePreBanksReloaded();
-    void HandleBanksReloaded();
+    void HandleBanksReloaded(const FFMODBankChanges &Changes);
     void HandleBeginPIE(bool bSimulating);
 
     /** Creates all internal widgets for the tabs to point at */
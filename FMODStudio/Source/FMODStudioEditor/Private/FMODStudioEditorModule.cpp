@@ -5,6 +5,9 @@
 #include "FMODStudioStyle.h"
 #include "FMODAudioComponent.h"
 #include "FMODAssetBroker.h"
+#include "FMODBank.h"
+#include "FMODEvent.h"
+#include "FMODLevelBankManifest.h"
 #include "FMODSettings.h"
 #include "FMODUtils.h"
 
@@ -46,6 +49,10 @@
 #include "HAL/FileManager.h"
 #include "Interfaces/IMainFrameModule.h"
 #include "ToolMenus.h"
+#include "AssetRegistryModule.h"
+#include "Engine/Level.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectHash.h"
 
 #include "fmod_studio.hpp"
 
@@ -187,7 +194,7 @@ public:
     bool HandleSettingsSaved();
 
     /** Called after all banks were reloaded by the studio module */
-    void HandleBanksReloaded();
+    void HandleBanksReloaded(const FFMODBankChanges &Changes);
 
     /** Show notification */
     void ShowNotification(const FText &Text, SNotificationItem::ECompletionState State);
@@ -197,6 +204,9 @@ public:
     void PausePIE(bool simulating);
     void ResumePIE(bool simulating);
 
+    /** Records the banks and events a level uses so they can be preloaded when it streams in */
+    void PreSaveWorld(uint32 SaveFlags, UWorld *World);
+
     void ViewportDraw(UCanvas *Canvas, APlayerController *);
 
     bool Tick(float DeltaTime);
@@ -243,6 +253,7 @@ public:
     FDelegateHandle EndPIEDelegateHandle;
     FDelegateHandle PausePIEDelegateHandle;
     FDelegateHandle ResumePIEDelegateHandle;
+    FDelegateHandle PreSaveWorldDelegateHandle;
     FDelegateHandle HandleBanksReloadedDelegateHandle;
     FDelegateHandle FMODControlTrackEditorCreateTrackEditorHandle;
     FDelegateHandle FMODParamTrackEditorCreateTrackEditorHandle;
@@ -342,6 +353,7 @@ void FFMODStudioEditorModule::StartupModule()
     EndPIEDelegateHandle = FEditorDelegates::EndPIE.AddRaw(this, &FFMODStudioEditorModule::EndPIE);
     PausePIEDelegateHandle = FEditorDelegates::PausePIE.AddRaw(this, &FFMODStudioEditorModule::PausePIE);
     ResumePIEDelegateHandle = FEditorDelegates::ResumePIE.AddRaw(this, &FFMODStudioEditorModule::ResumePIE);
+    PreSaveWorldDelegateHandle = FEditorDelegates::PreSaveWorld.AddRaw(this, &FFMODStudioEditorModule::PreSaveWorld);
 
     ViewportDrawingDelegate = FDebugDrawDelegate::CreateRaw(this, &FFMODStudioEditorModule::ViewportDraw);
     ViewportDrawingDelegateHandle = UDebugDrawService::Register(TEXT("Editor"), ViewportDrawingDelegate);
@@ -422,7 +434,7 @@ void FFMODStudioEditorModule::AddFileMenuExtension(FMenuBuilder &MenuBuilder)
 
 unsigned int GetDLLVersion()
 {
-    // Just grab it from the audition context which is always valid
+    // Just grab it from the audition context, which is created on demand
     unsigned int DLLVersion = 0;
     FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Auditioning);
     if (StudioSystem)
@@ -1017,8 +1029,10 @@ bool FFMODStudioEditorModule::Tick(float DeltaTime)
         TickTest(DeltaTime);
     }
 
-    // Update listener position for Editor sound system
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Editor);
+    // Update listener position for Editor sound system, if anything has needed it yet
+    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().HasStudioSystem(EFMODSystemContext::Editor)
+                                             ? IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Editor)
+                                             : nullptr;
     if (StudioSystem)
     {
         if (GCurrentLevelEditingViewportClient)
@@ -1196,6 +1210,7 @@ void FFMODStudioEditorModule::ShutdownModule()
         FEditorDelegates::EndPIE.Remove(EndPIEDelegateHandle);
         FEditorDelegates::PausePIE.Remove(PausePIEDelegateHandle);
         FEditorDelegates::ResumePIE.Remove(ResumePIEDelegateHandle);
+        FEditorDelegates::PreSaveWorld.Remove(PreSaveWorldDelegateHandle);
 
         if (ViewportDrawingDelegate.IsBound())
         {
@@ -1254,7 +1269,115 @@ bool FFMODStudioEditorModule::HandleSettingsSaved()
     return true;
 }
 
-void FFMODStudioEditorModule::HandleBanksReloaded()
+void FFMODStudioEditorModule::PreSaveWorld(uint32 SaveFlags, UWorld *World)
+{
+    ULevel *Level = World ? World->PersistentLevel : nullptr;
+    if (!Level)
+    {
+        return;
+    }
+
+    // A manifest from an earlier save is stale either way, and only rebuilt while preloading is enabled
+    Level->RemoveUserDataOfClass(UFMODLevelBankManifest::StaticClass());
+
+    if (!GetDefault<UFMODSettings>()->bPreloadLevelBanks)
+    {
+        return;
+    }
+
+    TSet<UFMODEvent *> Events;
+
+    // Components placed in the level, including those owned by ambient sounds
+    ForEachObjectWithOuter(Level, [&Events](UObject *Object) {
+        if (UFMODAudioComponent *Component = Cast<UFMODAudioComponent>(Object))
+        {
+            if (UFMODEvent *Event = Cast<UFMODEvent>(IFMODStudioModule::Get().FindAssetByPath(Component->Event.ToSoftObjectPath())))
+            {
+                Events.Add(Event);
+            }
+        }
+    });
+
+    // Anim notifies, sequences and blueprints live in other packages, so follow the level's dependencies to the FMOD assets they use.
+    // Soft references are skipped, they are often tables of assets that are only loaded on demand.
+    IAssetRegistry &AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    const FString FMODPrefix = GetDefault<UFMODSettings>()->ContentBrowserPrefix;
+    TArray<FName> PendingPackages;
+    TSet<FName> VisitedPackages;
+    PendingPackages.Add(World->GetOutermost()->GetFName());
+    VisitedPackages.Add(PendingPackages[0]);
+
+    while (PendingPackages.Num() > 0)
+    {
+        TArray<FName> Dependencies;
+        AssetRegistry.GetDependencies(PendingPackages.Pop(false), Dependencies, EAssetRegistryDependencyType::Hard);
+
+        for (FName Dependency : Dependencies)
+        {
+            if (VisitedPackages.Contains(Dependency))
+            {
+                continue;
+            }
+            VisitedPackages.Add(Dependency);
+
+            FString PackageName = Dependency.ToString();
+            if (PackageName.StartsWith(FMODPrefix))
+            {
+                FSoftObjectPath AssetPath(PackageName + TEXT(".") + FPackageName::GetShortName(PackageName));
+                if (UFMODEvent *Event = Cast<UFMODEvent>(IFMODStudioModule::Get().FindAssetByPath(AssetPath)))
+                {
+                    Events.Add(Event);
+                }
+            }
+            else if (!PackageName.StartsWith(TEXT("/Script/")) && !PackageName.StartsWith(TEXT("/Engine/")))
+            {
+                PendingPackages.Add(Dependency);
+            }
+        }
+    }
+
+    if (Events.Num() == 0)
+    {
+        return;
+    }
+
+    TSet<FGuid> EventGuids;
+    for (UFMODEvent *Event : Events)
+    {
+        EventGuids.Add(Event->AssetGuid);
+    }
+
+    // Studio systems aren't created while cooking, so the asset table looks inside the bank files instead
+    TArray<UFMODBank *> Banks;
+    IFMODStudioModule::Get().GetBanksContainingEvents(EventGuids, Banks);
+    if (Banks.Num() == 0)
+    {
+        UE_LOG(LogFMOD, Warning, TEXT("Could not find the FMOD banks containing the events used by level %s, not recording a manifest"),
+            *World->GetOutermost()->GetName());
+        return;
+    }
+
+    UFMODLevelBankManifest *Manifest = NewObject<UFMODLevelBankManifest>(Level);
+
+    for (UFMODEvent *Event : Events)
+    {
+        Manifest->Events.Add(FSoftObjectPath(Event));
+    }
+    Manifest->Events.Sort([](const FSoftObjectPath &A, const FSoftObjectPath &B) { return A.ToString() < B.ToString(); });
+
+    for (UFMODBank *Bank : Banks)
+    {
+        Manifest->Banks.AddUnique(FSoftObjectPath(Bank));
+    }
+    Manifest->Banks.Sort([](const FSoftObjectPath &A, const FSoftObjectPath &B) { return A.ToString() < B.ToString(); });
+
+    Level->AddAssetUserData(Manifest);
+
+    UE_LOG(LogFMOD, Log, TEXT("Recorded %d FMOD banks and %d events for level %s"), Manifest->Banks.Num(), Manifest->Events.Num(),
+        *World->GetOutermost()->GetName());
+}
+
+void FFMODStudioEditorModule::HandleBanksReloaded(const FFMODBankChanges &Changes)
 {
     // Show a reload notification
     TArray<FString> FailedBanks = IFMODStudioModule::Get().GetFailedBankLoads(EFMODSystemContext::Auditioning);